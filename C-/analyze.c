@@ -9,50 +9,136 @@
 #include "globals.h"
 #include "symtab.h"
 #include "analyze.h"
+#include "intern.h"
+#include "scan.h"
 #include <string.h>
 
-/* counter for variable memory locations */
-static int location = 0;
-static char* scope = " ";
-int main_already_seem = 0;
-static void declarationError(TreeNode * t, char * message);
+static void declarationError(Node t, char * message);
 
-/* Procedure traverse is a generic recursive 
- * syntax tree traversal routine:
+/* STACKDEPTH is the number of frames the
+ * traversals keep on the C stack; deeper trees
+ * move the explicit stack to the heap
+ */
+#define STACKDEPTH 64
+
+/* A frame of the explicit traversal stack:
+ * a node whose children are being visited and
+ * the index of the next child to visit
+ */
+typedef struct
+   { Node node;
+     int next;
+   } Frame;
+
+typedef struct
+   { Frame * frames;
+     int top;  /* number of frames in use */
+     int size; /* number of frames allocated */
+     Frame local[STACKDEPTH];
+   } Stack;
+
+/* Function push pushes node onto stack s and
+ * returns its frame; frames move to the heap
+ * when s outgrows its local storage
+ */
+static Frame * push( Stack * s, Node node )
+{ Frame * f;
+  if (s->top == s->size)
+  { Frame * frames = (Frame *) malloc(2*s->size*sizeof(Frame));
+    if (frames == NULL)
+    { fprintf(listing,"Out of memory error at line %d\n",lineOf(POS(node)));
+      exit(1);
+    }
+    memcpy(frames,s->frames,s->size*sizeof(Frame));
+    if (s->frames != s->local) free(s->frames);
+    s->frames = frames;
+    s->size *= 2;
+  }
+  f = &s->frames[s->top++];
+  f->node = node;
+  f->next = 0;
+  return f;
+}
+
+/* Function nextChild returns the next non-null
+ * child of the node in frame f, or NONODE once
+ * every child has been visited
+ */
+static Node nextChild( Frame * f )
+{ while (f->next < MAXCHILDREN)
+  { Node c = CHILD(f->node,f->next++);
+    if (c != NONODE) return c;
+  }
+  return NONODE;
+}
+
+/* Procedure traverse is a generic syntax tree
+ * traversal routine:
  * it applies preProc in preorder and postProc 
- * in postorder to tree pointed to by t
+ * in postorder to tree pointed to by t.
+ * Siblings are visited by iteration and children
+ * through an explicit stack, so neither long
+ * sequences nor deep nesting use the C stack
  */
-static void traverse( TreeNode * t,
-               void (* preProc) (TreeNode *),
-               void (* postProc) (TreeNode *) )
-{ if (t != NULL)
-  { preProc(t);
-    { int i;
-      for (i=0; i < MAXCHILDREN; i++)
-        traverse(t->child[i],preProc,postProc);
+static void traverse( Node t,
+               void (* preProc) (Node),
+               void (* postProc) (Node) )
+{ Stack s;
+  s.frames = s.local;
+  s.top = 0;
+  s.size = STACKDEPTH;
+  for (;;)
+  { if (t != NONODE)
+    { compilation->visits++;
+      preProc(t);
+      push(&s,t);
+    }
+    else if (s.top == 0) break;
+    t = nextChild(&s.frames[s.top-1]);
+    if (t == NONODE)
+    { Node done = s.frames[--s.top].node;
+      postProc(done);
+      t = SIBLING(done);
     }
-    postProc(t);
-    traverse(t->sibling,preProc,postProc);
   }
+  if (s.frames != s.local) free(s.frames);
 }
 
-/* nullProc is a do-nothing procedure to 
- * generate preorder-only or postorder-only
- * traversals from traverse
+/* Procedure postorder applies proc in postorder
+ * to tree pointed to by t; it is traverse
+ * without the indirect call of a do-nothing
+ * preorder procedure at every node
  */
-static void nullProc(TreeNode * t)
-{ if (t==NULL) return;
-  else return;
+static void postorder( Node t, void (* proc) (Node) )
+{ Stack s;
+  s.frames = s.local;
+  s.top = 0;
+  s.size = STACKDEPTH;
+  for (;;)
+  { if (t != NONODE)
+    { compilation->visits++;
+      push(&s,t);
+    }
+    else if (s.top == 0) break;
+    t = nextChild(&s.frames[s.top-1]);
+    if (t == NONODE)
+    { Node done = s.frames[--s.top].node;
+      proc(done);
+      t = SIBLING(done);
+    }
+  }
+  if (s.frames != s.local) free(s.frames);
 }
 
 /* Procedure insertNode inserts 
  * identifiers stored in t into 
  * the symbol table 
  */
-static void insertNode( TreeNode * t)
-{ switch (t->nodekind)
+static void insertNode( Node t)
+{ int created;
+  switch (NODEKIND(t))
   { case StmtK:
-      switch (t->kind.stmt)
+      switch (STMTKIND(t))
       { case AssignK: break;
         case IfK: break;
         case WhileK: break;
@@ -60,52 +146,54 @@ static void insertNode( TreeNode * t)
         case ParamsK: break;
         
         case CallK:
-          if (st_lookup(t->attr.name, scope) == -1)
+          SYMBOL(t) = st_find(ATTR(t).name);
+          if (SYMBOL(t) == NULL)
               declarationError(t, "function called was not declared");
           break;
 
         case FuncK:
-          scope = t->attr.name;
-          if(strcmp(t->attr.name, "main") == 0)
-              main_already_seem = 1;
+          if(ATTR(t).name == internString("main"))
+              compilation->main_already_seem = 1;
 
-          if(st_lookup(t->attr.name, " ") == -1)
-          {
-              if(t->type==Integer)
-                  st_insert(t->attr.name, t->lineno, location++, " ", "function", "int");
-              else
-                  st_insert(t->attr.name, t->lineno, location++, " ", "function", "void");
-          }
+          SYMBOL(t) = st_find_or_insert(ATTR(t).name, POS(t), compilation->location, "function",
+                            TYPE(t)==Integer ? "int" : "void", &created);
+          if (created)
+              compilation->location++;
           else 
           {
             declarationError(t, "name already used by another function");
           }
+          st_enter_scope(ATTR(t).name);
         default: break;
       }
       break;
 
   case ExpK:
-      switch (t->kind.exp)
+      switch (EXPKIND(t))
       { 
-        case VectorK: break;
         case OpK: break;
         case ConstK: break;
 
         case IdK:
-          if (st_lookup(t->attr.name, scope) == -1)
-              declarationError(t, "variable not declared in this scope");
-          else
-            if(t->already_seem == 0)
-                st_insert(t->attr.name, t->lineno, 0, scope, " ", " ");
+        case VectorK:
+          if(SEEN(t) == 0)
+          {
+              SYMBOL(t) = st_find(ATTR(t).name);
+              if (SYMBOL(t) == NULL)
+                  declarationError(t, "variable not declared in this scope");
+              else
+                  st_add_line(SYMBOL(t), POS(t));
+          }
           break;
 
         case TypeK:
-          if(t->type == Integer) 
+          if(TYPE(t) == Integer) 
           {
-              if(st_lookup(t->child[0]->attr.name, scope) == -1)
+              SYMBOL(CHILD(t,0)) = st_find_or_insert(ATTR(CHILD(t,0)).name, POS(CHILD(t,0)), compilation->location, "var", "int", &created);
+              if(created)
               {
-                  st_insert(t->child[0]->attr.name, t->child[0]->lineno, location++, scope, "var", "int");
-                  t->child[0]->already_seem = 1;
+                  compilation->location++;
+                  SEEN(CHILD(t,0)) = 1;
               } else 
               {
                   declarationError(t, "name already used by another variable previosly declared in this scope or by another function");
@@ -113,7 +201,7 @@ static void insertNode( TreeNode * t)
           }
           else 
           {
-              if(t->type == Void)
+              if(TYPE(t) == Void)
                   declarationError(t, "variable must not be declared as void");
           }          
           break;
@@ -125,16 +213,25 @@ static void insertNode( TreeNode * t)
   }
 }
 
+/* Procedure exitNode closes the scope of a
+ * function once its whole subtree has been
+ * visited
+ */
+static void exitNode( Node t)
+{ if ((NODEKIND(t) == StmtK) && (STMTKIND(t) == FuncK))
+    st_exit_scope();
+}
+
 static void mainError()
-{ if (main_already_seem == 0) {fprintf(listing,"Error: main must be declared\n");
+{ if (compilation->main_already_seem == 0) {fprintf(listing,"Error: main must be declared\n");
    Error = TRUE;}
 }
 
 /* Function buildSymtab constructs the symbol 
  * table by preorder traversal of the syntax tree
  */
-void buildSymtab(TreeNode * syntaxTree)
-{ traverse(syntaxTree,insertNode,nullProc);
+void buildSymtab(Node syntaxTree)
+{ traverse(syntaxTree,insertNode,exitNode);
   if (TraceAnalyze)
   { 
     mainError();
@@ -143,45 +240,45 @@ void buildSymtab(TreeNode * syntaxTree)
   }
 }
 
-static void typeError(TreeNode * t, char * message)
-{ fprintf(listing,"Type error at line %d: %s\n",t->lineno,message);
+static void typeError(Node t, char * message)
+{ fprintf(listing,"Type error at line %d: %s\n",lineOf(POS(t)),message);
   Error = TRUE;
 }
 
-static void declarationError(TreeNode * t, char * message)
-{ fprintf(listing,"Declaration error at line %d: %s\n",t->lineno,message);
+static void declarationError(Node t, char * message)
+{ fprintf(listing,"Declaration error at line %d: %s\n",lineOf(POS(t)),message);
   Error = TRUE;
 }
 
 /* Procedure checkNode performs
  * type checking at a single tree node
  */
-static void checkNode(TreeNode * t)
-{ switch (t->nodekind)
+static void checkNode(Node t)
+{ switch (NODEKIND(t))
   { case ExpK:
-      switch (t->kind.exp)
+      switch (EXPKIND(t))
       { case OpK:
-          if ((t->child[0]->type != Integer) ||
-              (t->child[1]->type != Integer))
+          if ((TYPE(CHILD(t,0)) != Integer) ||
+              (TYPE(CHILD(t,1)) != Integer))
             typeError(t,"Op applied to non-integer");
 
-          if ((t->attr.op == EQUAL) || (t->attr.op == LT) || (t->attr.op == GT) || (t->attr.op == DIFF) || (t->attr.op == LTEQ) 
-            || (t->attr.op == GTEQ) )
-            t->type = Boolean;
+          if ((ATTR(t).op == EQUAL) || (ATTR(t).op == LT) || (ATTR(t).op == GT) || (ATTR(t).op == DIFF) || (ATTR(t).op == LTEQ) 
+            || (ATTR(t).op == GTEQ) )
+            TYPE(t) = Boolean;
           else
-            t->type = Integer;
+            TYPE(t) = Integer;
           break;
 
         case ConstK: 
-            t->type = Integer; 
+            TYPE(t) = Integer; 
             break;
 
         case IdK:
-          t->type = Integer;
+          TYPE(t) = Integer;
           break;
 
         case VectorK:
-            t->type = Integer; break;
+            TYPE(t) = Integer; break;
 
         case TypeK: break;
 
@@ -191,27 +288,27 @@ static void checkNode(TreeNode * t)
       break;
 
     case StmtK:
-      switch (t->kind.stmt)
+      switch (STMTKIND(t))
       { case IfK:
-          if (t->child[0]->type == Integer)
-            typeError(t->child[0],"if test is not Boolean");
+          if (TYPE(CHILD(t,0)) == Integer)
+            typeError(CHILD(t,0),"if test is not Boolean");
           break;
 
         case AssignK:
-          if (t->child[0]->type != t->child[1]->type)
-            typeError(t->child[0],"assignment error: different types");
+          if (TYPE(CHILD(t,0)) != TYPE(CHILD(t,1)))
+            typeError(CHILD(t,0),"assignment error: different types");
           break;
 
         case WhileK:
-          if (t->child[0]->type == Integer)
-            typeError(t->child[1],"while test is not Boolean");
+          if (TYPE(CHILD(t,0)) == Integer)
+            typeError(CHILD(t,1),"while test is not Boolean");
           break;
 
         case CallK:
-           if (checkFunctionType(t->attr.name)==1)
-              t->type = Integer;
+           if (checkFunctionType(SYMBOL(t))==1)
+              TYPE(t) = Integer;
           else
-              t->type = Void;
+              TYPE(t) = Void;
           break;
 
         case FuncK: break;
@@ -230,6 +327,51 @@ static void checkNode(TreeNode * t)
 /* Procedure typeCheck performs type checking 
  * by a postorder syntax tree traversal
  */
-void typeCheck(TreeNode * syntaxTree)
-{ traverse(syntaxTree,nullProc,checkNode);
+void typeCheck(Node syntaxTree)
+{ postorder(syntaxTree,checkNode);
+}
+
+/* Procedure checkExitNode type checks a node
+ * and then closes its scope if it is a function
+ */
+static void checkExitNode(Node t)
+{ checkNode(t);
+  exitNode(t);
+}
+
+/* Procedure analyze builds the symbol table and
+ * checks types in a single traversal: names are
+ * resolved in preorder and types computed in
+ * postorder, which is enough because C- requires
+ * every name to be declared before it is used
+ */
+void analyze(Node syntaxTree)
+{ traverse(syntaxTree,insertNode,checkExitNode);
+  finishAnalysis();
+}
+
+/* Procedure analyzeDeclaration analyzes the
+ * top-level declaration t as analyze does; the
+ * scope of a function is listed and discarded
+ * once the function is analyzed
+ */
+void analyzeDeclaration(Node t)
+{ traverse(t,insertNode,checkExitNode);
+  if (TraceAnalyze && (NODEKIND(t) == StmtK) && (STMTKIND(t) == FuncK))
+  { fprintf(listing,"\nSymbol table of %s:\n\n",ATTR(t).name);
+    st_flush_scopes(listing);
+  }
+  else st_flush_scopes(NULL);
+}
+
+/* Procedure finishAnalysis reports what can only
+ * be known once every declaration is analyzed
+ */
+void finishAnalysis(void)
+{ if (TraceAnalyze)
+  { 
+    mainError();
+    fprintf(listing,"\nSymbol table:\n\n");
+    printSymTab(listing);
+  }
 }
\ No newline at end of file
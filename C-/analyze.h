@@ -11,11 +11,33 @@
 /* Function buildSymtab constructs the symbol 
  * table by preorder traversal of the syntax tree
  */
-void buildSymtab(TreeNode *);
+void buildSymtab(Node);
 
 /* Procedure typeCheck performs type checking 
  * by a postorder syntax tree traversal
  */
-void typeCheck(TreeNode *);
+void typeCheck(Node);
+
+/* Procedure analyze does the work of buildSymtab
+ * and typeCheck in a single traversal of the
+ * syntax tree
+ */
+void analyze(Node);
+
+/* Procedure analyzeDeclaration analyzes the
+ * top-level declaration t, whose siblings are
+ * not parsed yet, as analyze does. Declarations
+ * must be given in the order of the source, and
+ * finishAnalysis called after the last one. Only
+ * the global symbols are kept: the symbols of a
+ * function are discarded once it is analyzed, so
+ * that the tree of t may be freed
+ */
+void analyzeDeclaration(Node t);
+
+/* Procedure finishAnalysis ends the analysis of
+ * a program analyzed one declaration at a time
+ */
+void finishAnalysis(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+/****************************************************/
+/* File: arena.c                                    */
+/* Bump-pointer memory arena implementation         */
+/* for the CMINUS compiler                          */
+/****************************************************/
+
+#include <stdlib.h>
+#include "arena.h"
+
+/* size of the block header, rounded up so that
+ * the storage following it stays aligned
+ */
+#define HEADERSIZE \
+  ((sizeof(struct ArenaChunkRec)+ARENAALIGN-1) & ~(size_t)(ARENAALIGN-1))
+
+/* Function newChunk obtains from malloc a block with
+ * at least size usable bytes and makes it current
+ */
+static int newChunk(Arena * a, size_t size)
+{ ArenaChunk c;
+  if (size < ARENACHUNK) size = ARENACHUNK;
+  c = (ArenaChunk) malloc(HEADERSIZE + size);
+  if (c == NULL) return 0;
+  c->size = size;
+  c->next = a->chunks;
+  a->chunks = c;
+  a->next = (char *) c + HEADERSIZE;
+  a->limit = a->next + size;
+  a->reserved += HEADERSIZE + size;
+  a->nchunks++;
+  return 1;
+}
+
+/* Function arenaAlloc returns size bytes of storage
+ * from arena a, or NULL if memory is exhausted
+ */
+void * arenaAlloc(Arena * a, size_t size)
+{ void * p;
+  size = (size + ARENAALIGN-1) & ~(size_t)(ARENAALIGN-1);
+  if ((size_t)(a->limit - a->next) < size)
+    if (!newChunk(a,size)) return NULL;
+  p = a->next;
+  a->next += size;
+  a->allocs++;
+  a->bytes += size;
+  return p;
+}
+
+/* Procedure arenaRelease frees every block owned by
+ * arena a and leaves it empty and ready for reuse
+ */
+void arenaRelease(Arena * a)
+{ ArenaChunk c = a->chunks;
+  while (c != NULL)
+  { ArenaChunk next = c->next;
+    free(c);
+    c = next;
+  }
+  a->chunks = NULL;
+  a->next = a->limit = NULL;
+  a->allocs = a->bytes = a->reserved = a->nchunks = 0;
+}
@@ -0,0 +1,50 @@
+/****************************************************/
+/* File: arena.h                                    */
+/* Bump-pointer memory arena for the CMINUS         */
+/* compiler: everything allocated from an arena is  */
+/* released at once by arenaRelease                 */
+/****************************************************/
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <stddef.h>
+
+/* ARENACHUNK is the size in bytes of each block
+ * the arena requests from malloc
+ */
+#define ARENACHUNK 65536
+
+/* ARENAALIGN is the alignment of every pointer
+ * returned by arenaAlloc (a power of two)
+ */
+#define ARENAALIGN 8
+
+/* the blocks owned by an arena, most recent first */
+typedef struct ArenaChunkRec
+   { struct ArenaChunkRec * next;
+     size_t size; /* usable bytes after the header */
+   } * ArenaChunk;
+
+typedef struct
+   { ArenaChunk chunks;
+     char * next;  /* first free byte of the current block */
+     char * limit; /* end of the current block */
+     /* allocation counters, reset by arenaRelease */
+     unsigned long allocs;   /* number of arenaAlloc calls */
+     unsigned long bytes;    /* bytes handed out */
+     unsigned long reserved; /* bytes obtained from malloc */
+     unsigned long nchunks;  /* blocks obtained from malloc */
+   } Arena;
+
+/* Function arenaAlloc returns size bytes of storage
+ * from arena a, or NULL if memory is exhausted
+ */
+void * arenaAlloc(Arena * a, size_t size);
+
+/* Procedure arenaRelease frees every block owned by
+ * arena a and leaves it empty and ready for reuse
+ */
+void arenaRelease(Arena * a);
+
+#endif
@@ -0,0 +1,204 @@
+/****************************************************/
+/* File: gen.c                                      */
+/* Generator of synthetic C- sources for the        */
+/* benchmarks of the CMINUS compiler                */
+/****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Procedure seq writes a single function with n
+ * assignment statements in a row
+ */
+static void seq( unsigned long n )
+{ unsigned long i;
+  printf("void main(void)\n{ int x;\n");
+  for (i=0;i<n;i++)
+    printf("  x = x + %lu;\n",i % 1000);
+  printf("}\n");
+}
+
+/* Function name writes into buf the name made of
+ * prefix followed by the number n in letters,
+ * since C- names have no digits, and returns buf
+ */
+static char * name( char * buf, char prefix, unsigned long n )
+{ char digits[16];
+  int k = 0, i = 0;
+  do
+  { digits[k++] = (char) ('a' + n % 26);
+    n /= 26;
+  } while (n > 0);
+  buf[i++] = prefix;
+  while (k > 0) buf[i++] = digits[--k];
+  buf[i] = '\0';
+  return buf;
+}
+
+/* Procedure globals writes n global variable
+ * declarations and a main function using them
+ */
+static void globals( unsigned long n )
+{ char buf[16];
+  unsigned long i;
+  for (i=0;i<n;i++)
+    printf("int %s;\n",name(buf,'g',i));
+  printf("void main(void)\n{ ga = %s; }\n",name(buf,'g',n-1));
+}
+
+/* Procedure funcs writes n small functions, each
+ * calling the one before it
+ */
+static void funcs( unsigned long n )
+{ char buf[16], prev[16];
+  unsigned long i;
+  printf("int fa(int a)\n{ return a; }\n");
+  for (i=1;i<n;i++)
+    printf("int %s(int a)\n{ int b;\n  b = a + %lu;\n  return %s(b);\n}\n",
+           name(buf,'f',i),i % 1000,name(prev,'f',i-1));
+  printf("void main(void)\n{ %s(0); }\n",name(buf,'f',n-1));
+}
+
+/* Procedure nest writes depth while statements
+ * nested in one another around an assignment of
+ * an expression nested in parens parentheses
+ */
+static void nest( unsigned long depth, unsigned long parens )
+{ unsigned long i;
+  printf("void main(void)\n{ int x;\n");
+  for (i=0;i<depth;i++)
+    printf("while (x < %lu)\n",i % 1000);
+  printf("x = ");
+  for (i=0;i<parens;i++) putchar('(');
+  printf("x");
+  for (i=0;i<parens;i++) printf(" + 1)");
+  printf(";\n}\n");
+}
+
+/* LICENSE is the 20-line comment comments
+ * writes before every function
+ */
+#define LICENSE \
+  "/*\n" \
+  " * Copyright (c) the authors of this program.\n" \
+  " *\n" \
+  " * Permission is hereby granted, free of charge, to any person\n" \
+  " * obtaining a copy of this software and associated documentation\n" \
+  " * files (the \"Software\"), to deal in the Software without\n" \
+  " * restriction, including without limitation the rights to use,\n" \
+  " * copy, modify, merge, publish, distribute, sublicense, and/or sell\n" \
+  " * copies of the Software, and to permit persons to whom the\n" \
+  " * Software is furnished to do so, subject to the following\n" \
+  " * conditions:\n" \
+  " *\n" \
+  " * The above copyright notice and this permission notice shall be\n" \
+  " * included in all copies or substantial portions of the Software.\n" \
+  " *\n" \
+  " * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND,\n" \
+  " * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES\n" \
+  " * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND\n" \
+  " * NONINFRINGEMENT.\n" \
+  " */\n"
+
+/* Procedure comments writes about mb megabytes
+ * of small functions, each one after a license
+ * comment, so that most of the text is comments
+ */
+static void comments( unsigned long mb )
+{ char buf[16];
+  unsigned long i, size = 0;
+  for (i=0;size<mb*1000000;i++)
+    size += printf(LICENSE "int %s(int a)\n{ return a + %lu; }\n",
+                   name(buf,'f',i),i % 1000);
+  printf("void main(void)\n{ fa(0); }\n");
+}
+
+/* Procedure program writes about mb megabytes
+ * of functions with loops, conditions, vectors
+ * and calls, each calling the one before it
+ */
+static void program( unsigned long mb )
+{ char buf[16], prev[16];
+  unsigned long i, size = 0;
+  printf("int input(void) { }\nvoid output(int x) { }\nint g[100];\n");
+  for (i=0;size<mb*1000000;i++)
+    size += printf("/* function %lu computes\n   something */\n"
+                   "int %s(int a, int b[])\n"
+                   "{\n"
+                   "  int i; int s; int t[10];\n"
+                   "  i = 0; s = a;\n"
+                   "  while (i < 10) {\n"
+                   "    t[i] = b[i] * (a + %lu) / (i + 1) - s;\n"
+                   "    if (t[i] >= s) s = s + t[i]; else s = s - 1;\n"
+                   "    i = i + 1;\n"
+                   "  }\n"
+                   "  output(s);\n"
+                   "  return s + %s(a - 1, b);\n"
+                   "}\n\n",
+                   i,name(buf,'f',i),i,name(prev,'f',i ? i-1 : 0));
+  printf("void main(void)\n{ int x; x = input(); output(%s(x, g)); }\n",
+         name(buf,'f',i-1));
+}
+
+/* Procedure huge writes about mb megabytes in
+ * n functions, whose bodies repeat the loop of
+ * program's, so that a single function is large
+ */
+static void huge( unsigned long mb, unsigned long n )
+{ char buf[16];
+  unsigned long i, size;
+  printf("int input(void) { }\nvoid output(int x) { }\nint g[100];\n");
+  for (i=0;i<n;i++)
+  { printf("int %s(int a, int b[])\n"
+           "{\n"
+           "  int i; int s; int t[10];\n"
+           "  s = a;\n",name(buf,'f',i));
+    for (size=0;size<mb*1000000/n;)
+      size += printf("  i = 0;\n"
+                     "  while (i < 10) {\n"
+                     "    t[i] = b[i] * (a + %lu) / (i + 1) - s;\n"
+                     "    if (t[i] >= s) s = s + t[i]; else s = s - 1;\n"
+                     "    i = i + 1;\n"
+                     "  }\n",size % 1000);
+    printf("  return s;\n}\n\n");
+  }
+  printf("void main(void)\n{ int x; x = input(); output(%s(x, g)); }\n",
+         name(buf,'f',n-1));
+}
+
+/* Procedure usage describes the arguments and
+ * exits
+ */
+static void usage( const char * pgm )
+{ fprintf(stderr,"usage: %s seq <statements> | globals <declarations>\n"
+          "       | funcs <functions> | nest <depth> <parentheses>\n"
+          "       | comments <megabytes> | program <megabytes>\n"
+          "       | huge <megabytes> <functions>\n",pgm);
+  exit(1);
+}
+
+int main( int argc, char * argv[] )
+{ unsigned long n;
+  if (argc < 3) usage(argv[0]);
+  n = strtoul(argv[2],NULL,10);
+  if (n == 0) usage(argv[0]);
+  if ((strcmp(argv[1],"nest") == 0) && (argc == 4))
+    nest(n,strtoul(argv[3],NULL,10));
+  else if ((strcmp(argv[1],"huge") == 0) && (argc == 4)
+           && (strtoul(argv[3],NULL,10) > 0))
+    huge(n,strtoul(argv[3],NULL,10));
+  else if (argc != 3) usage(argv[0]);
+  else if (strcmp(argv[1],"seq") == 0)
+    seq(n);
+  else if (strcmp(argv[1],"globals") == 0)
+    globals(n);
+  else if (strcmp(argv[1],"funcs") == 0)
+    funcs(n);
+  else if (strcmp(argv[1],"comments") == 0)
+    comments(n);
+  else if (strcmp(argv[1],"program") == 0)
+    program(n);
+  else usage(argv[0]);
+  return 0;
+}
@@ -0,0 +1,113 @@
+/****************************************************/
+/* File: symbench.c                                 */
+/* Symbol table micro-benchmark for the CMINUS      */
+/* compiler: inserts N distinct globals, then looks */
+/* each one up LOOKUPS times in a scattered order   */
+/****************************************************/
+
+#include "globals.h"
+#include "symtab.h"
+#include "intern.h"
+#include <time.h>
+
+/* LOOKUPS is the number of times each name
+ * is looked up
+ */
+#define LOOKUPS 10
+
+#ifdef THREAD
+/* the compiler state the table works in, which
+ * main.c defines in the compiler
+ */
+THREAD unsigned position = 0;
+THREAD FILE * listing;
+THREAD Compilation * compilation = NULL;
+int Streaming = FALSE;
+
+/* Function lineOf stands in for the scanner's:
+ * the benchmark passes line numbers as offsets
+ */
+int lineOf(unsigned offset)
+{ return (int) offset;
+}
+#else
+/* the chained tables of the earlier compiler
+ * (before growable scopes) use these instead
+ */
+FILE * listing;
+int lineno = 0;
+#endif
+
+/* Function seconds returns the time elapsed
+ * since start
+ */
+static double seconds( struct timespec * start )
+{ struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* Function stride returns a step coprime with n,
+ * so that i*stride % n visits every name once in
+ * an order unrelated to the order of insertion
+ */
+static unsigned long stride( unsigned long n )
+{ unsigned long s = 7919;
+  for (;;)
+  { unsigned long a = n, b = s;
+    while (b != 0)
+    { unsigned long r = a % b;
+      a = b;
+      b = r;
+    }
+    if (a == 1) return s % n;
+    s += 2;
+  }
+}
+
+int main( int argc, char * argv[] )
+{ unsigned long n, i, step, k;
+  char ** names;
+  char buf[32];
+  struct timespec start;
+  double insert, lookup;
+  long sum = 0;
+  if ((argc != 2) || ((n = strtoul(argv[1],NULL,10)) == 0))
+  { fprintf(stderr,"usage: %s <number of names>\n",argv[0]);
+    exit(1);
+  }
+  listing = stdout;
+#ifdef THREAD
+  compilation = (Compilation *) calloc(1,sizeof(Compilation));
+#endif
+  names = (char **) malloc(n*sizeof(char *));
+  if (names == NULL)
+  { fprintf(stderr,"Out of memory\n");
+    exit(1);
+  }
+  /* the names are interned beforehand: only
+   * the table is timed
+   */
+  for (i=0;i<n;i++)
+  { sprintf(buf,"v%lu",i);
+    names[i] = internString(buf);
+  }
+  clock_gettime(CLOCK_MONOTONIC,&start);
+  for (i=0;i<n;i++)
+    st_insert(names[i],(unsigned) i+1,(int) i,"var","int");
+  insert = seconds(&start);
+  step = (n == 1) ? 0 : stride(n);
+  clock_gettime(CLOCK_MONOTONIC,&start);
+  for (k=0;k<LOOKUPS;k++)
+    for (i=0;i<n;i++)
+      sum += st_lookup(names[(i*step + k) % n]);
+  lookup = seconds(&start);
+  /* every location is looked up LOOKUPS times */
+  if (sum != (long) LOOKUPS * (long) (n*(n-1)/2))
+  { fprintf(stderr,"lookups returned wrong locations\n");
+    exit(1);
+  }
+  printf("%8lu names: insert %.1f Mops/s, lookup %.1f Mops/s\n",n,
+         n / insert / 1e6,LOOKUPS * n / lookup / 1e6);
+  return 0;
+}
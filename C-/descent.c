@@ -0,0 +1,488 @@
+/****************************************************/
+/* File: descent.c                                  */
+/* Hand-written recursive-descent parser for the    */
+/* CMINUS compiler, with precedence climbing for    */
+/* expressions; it builds the same tree as tiny.y   */
+/****************************************************/
+
+#include "globals.h"
+#include "util.h"
+#include "parse.h"
+#include "intern.h"
+
+/* MAXDEPTH is the deepest nesting of statements
+ * and expressions the parser accepts, so that a
+ * pathological source cannot overflow the stack
+ * (the bison parser has YYMAXDEPTH)
+ */
+#define MAXDEPTH 10000
+
+/* The state of a parse. A token is read only
+ * once the parser has to look at it, so that
+ * position, and with it the position of each
+ * node made, is the same as in the bison parser,
+ * which reads a lookahead token only when its
+ * state has more than one action
+ */
+typedef struct
+   { Compilation * unit;
+     TokenType token; /* the next token, once peeked */
+     YYSTYPE value;   /* its semantic value */
+     int peeked;      /* TRUE while token is not consumed */
+     int failed;      /* TRUE after a syntax error */
+     int depth;       /* statements and expressions open */
+   } Parser;
+
+/* precedence of the binary operators, 0 for any
+ * other token; relational operators do not
+ * associate
+ */
+#define RELATIONAL 1
+#define ADDITIVE 2
+#define MULTIPLICATIVE 3
+
+static int precedence( TokenType token )
+{ switch (token)
+  { case TIMES: case OVER: return MULTIPLICATIVE;
+    case PLUS: case MINUS: return ADDITIVE;
+    case LT: case LTEQ: case GT: case GTEQ:
+    case EQUAL: case DIFF: return RELATIONAL;
+    default: return 0;
+  }
+}
+
+/* Function peek returns the next token without
+ * consuming it
+ */
+static TokenType peek( Parser * p )
+{ if (! p->peeked)
+  { p->token = parserToken(p->unit,&p->value);
+    p->peeked = TRUE;
+  }
+  return p->token;
+}
+
+/* Procedure advance consumes the token returned
+ * by peek; its value stays in p->value
+ */
+static void advance( Parser * p )
+{ p->peeked = FALSE;
+}
+
+/* Procedure fail reports a syntax error at the
+ * current token. Only the first one is reported:
+ * the parse stops there, as the bison parser
+ * does
+ */
+static void fail( Parser * p, const char * message )
+{ if (p->failed) return;
+  yyerror(p->unit,message);
+  p->failed = TRUE;
+}
+
+/* Function match consumes the next token if it
+ * is expected and fails otherwise
+ */
+static int match( Parser * p, TokenType expected )
+{ if (p->failed) return FALSE;
+  if (peek(p) != expected)
+  { fail(p,"syntax error");
+    return FALSE;
+  }
+  advance(p);
+  return TRUE;
+}
+
+/* Function enter opens a statement or expression,
+ * failing if they are nested too deep; leave
+ * closes it
+ */
+static int enter( Parser * p )
+{ if (p->failed) return FALSE;
+  if (p->depth == MAXDEPTH)
+  { fail(p,"memory exhausted");
+    return FALSE;
+  }
+  p->depth++;
+  return TRUE;
+}
+
+static void leave( Parser * p )
+{ p->depth--;
+}
+
+static NodeList statement( Parser * p );
+static Node expression( Parser * p );
+
+/* Function typeNode makes the node of type_id
+ * for token INT or VOID
+ */
+static Node typeNode( TokenType token )
+{ Node t = newExpNode(TypeK);
+  if (token == INT)
+  { TYPE(t) = Integer;
+    ATTR(t).name = internString("int");
+  }
+  else
+  { TYPE(t) = Void;
+    ATTR(t).name = internString("void");
+  }
+  return t;
+}
+
+/* type_id : INT | VOID */
+static Node typeId( Parser * p )
+{ TokenType token;
+  if (p->failed) return NONODE;
+  token = peek(p);
+  if ((token != INT) && (token != VOID))
+  { fail(p,"syntax error");
+    return NONODE;
+  }
+  advance(p);
+  return typeNode(token);
+}
+
+/* id : ID */
+static Node identifier( Parser * p )
+{ Node t;
+  if (! match(p,ID)) return NONODE;
+  t = newExpNode(IdK);
+  ATTR(t).name = p->value.name;
+  return t;
+}
+
+/* num : NUM */
+static Node number( Parser * p )
+{ Node t;
+  if (! match(p,NUM)) return NONODE;
+  t = newExpNode(ConstK);
+  ATTR(t).val = p->value.val;
+  return t;
+}
+
+/* args : arg_list | empty, after the LPAREN */
+static Node arguments( Parser * p )
+{ NodeList list;
+  if (peek(p) == RPAREN) return NONODE;
+  list = newList(expression(p));
+  while (! p->failed && (peek(p) == COMMA))
+  { advance(p);
+    list = appendList(list,newList(expression(p)));
+  }
+  return list.head;
+}
+
+/* Function reference parses var or call, which
+ * both begin with an id; *isVar tells which
+ */
+static Node reference( Parser * p, int * isVar )
+{ Node name = identifier(p);
+  Node t;
+  *isVar = TRUE;
+  if (p->failed) return NONODE;
+  if (peek(p) == LBRACKETS)
+  { Node index;
+    advance(p);
+    index = expression(p);
+    if (! match(p,RBRACKETS)) return NONODE;
+    t = newExpNode(VectorK);
+    ATTR(t).name = ATTR(name).name;
+    CHILD(t,0) = index;
+    return t;
+  }
+  if (peek(p) == LPAREN)
+  { Node args;
+    advance(p);
+    args = arguments(p);
+    if (! match(p,RPAREN)) return NONODE;
+    *isVar = FALSE;
+    t = newStmtNode(CallK);
+    ATTR(t).name = ATTR(name).name;
+    CHILD(t,0) = args;
+    return t;
+  }
+  return name;
+}
+
+/* factor : LPAREN exp RPAREN | var | call | num */
+static Node factor( Parser * p )
+{ Node t;
+  int isVar;
+  if (p->failed) return NONODE;
+  switch (peek(p))
+  { case LPAREN:
+      advance(p);
+      t = expression(p);
+      match(p,RPAREN);
+      return t;
+    case ID:
+      return reference(p,&isVar);
+    case NUM:
+      return number(p);
+    default:
+      fail(p,"syntax error");
+      return NONODE;
+  }
+}
+
+/* Function binary parses the operators of
+ * precedence min or above that follow the
+ * operand left, by precedence climbing, and
+ * returns the whole expression
+ */
+static Node binary( Parser * p, Node left, int min )
+{ for (;;)
+  { TokenType op;
+    int prec;
+    Node right, t;
+    if (p->failed) return NONODE;
+    op = peek(p);
+    prec = precedence(op);
+    if ((prec == 0) || (prec < min)) return left;
+    advance(p);
+    right = factor(p);
+    /* an operand of the tightest operators ends
+     * with its factor: bison makes their node
+     * before it reads the next token
+     */
+    if (prec < MULTIPLICATIVE) right = binary(p,right,prec+1);
+    if (p->failed) return NONODE;
+    t = newExpNode(OpK);
+    ATTR(t).op = op;
+    CHILD(t,0) = left;
+    CHILD(t,1) = right;
+    left = t;
+    if (prec == RELATIONAL) return left;
+  }
+}
+
+/* exp : var ASSIGN exp | simples_exp */
+static Node expression( Parser * p )
+{ Node t;
+  if (! enter(p)) return NONODE;
+  if (peek(p) == ID)
+  { int isVar;
+    Node left = reference(p,&isVar);
+    if (isVar && ! p->failed && (peek(p) == ASSIGN))
+    { Node right;
+      advance(p);
+      right = expression(p);
+      t = newStmtNode(AssignK);
+      CHILD(t,0) = left;
+      CHILD(t,1) = right;
+    }
+    else t = binary(p,left,RELATIONAL);
+  }
+  else t = binary(p,factor(p),RELATIONAL);
+  leave(p);
+  return t;
+}
+
+/* var_stmt after its type_id and id */
+static Node variable( Parser * p, Node type, Node name )
+{ if (p->failed) return NONODE;
+  CHILD(type,0) = name;
+  if (peek(p) == LBRACKETS)
+  { Node size;
+    advance(p);
+    /* made before the assignment: making a node
+     * may move the fields of the others
+     */
+    size = number(p);
+    CHILD(name,0) = size;
+    match(p,RBRACKETS);
+  }
+  match(p,SEMI);
+  return type;
+}
+
+/* comp_stmt : LKEY local_stmt stmtem_seq RKEY */
+static NodeList compound( Parser * p )
+{ NodeList list = newList(NONODE);
+  if (! match(p,LKEY)) return list;
+  while (! p->failed && ((peek(p) == INT) || (peek(p) == VOID)))
+  { Node type = typeId(p);
+    Node name = identifier(p);
+    list = appendList(list,newList(variable(p,type,name)));
+  }
+  while (! p->failed && (peek(p) != RKEY))
+    list = appendList(list,statement(p));
+  match(p,RKEY);
+  return list;
+}
+
+/* if_stmt : IF LPAREN exp RPAREN stmtem [ELSE stmtem] */
+static Node selection( Parser * p )
+{ Node test, t;
+  NodeList then, otherwise;
+  int hasElse = FALSE;
+  advance(p);
+  match(p,LPAREN);
+  test = expression(p);
+  match(p,RPAREN);
+  then = statement(p);
+  if (p->failed) return NONODE;
+  /* an ELSE belongs to the nearest IF */
+  if (peek(p) == ELSE)
+  { advance(p);
+    otherwise = statement(p);
+    if (p->failed) return NONODE;
+    hasElse = TRUE;
+  }
+  t = newStmtNode(IfK);
+  CHILD(t,0) = test;
+  CHILD(t,1) = then.head;
+  if (hasElse) CHILD(t,2) = otherwise.head;
+  return t;
+}
+
+/* while_stmt : WHILE LPAREN exp RPAREN stmtem */
+static Node iteration( Parser * p )
+{ Node test, t;
+  NodeList body;
+  advance(p);
+  match(p,LPAREN);
+  test = expression(p);
+  match(p,RPAREN);
+  body = statement(p);
+  if (p->failed) return NONODE;
+  t = newStmtNode(WhileK);
+  CHILD(t,0) = test;
+  CHILD(t,1) = body.head;
+  return t;
+}
+
+/* return_stmt : RETURN SEMI | RETURN exp SEMI */
+static Node jump( Parser * p )
+{ Node value, t;
+  advance(p);
+  if (peek(p) == SEMI)
+  { advance(p);
+    return newStmtNode(ReturnK);
+  }
+  value = expression(p);
+  if (! match(p,SEMI)) return NONODE;
+  t = newStmtNode(ReturnK);
+  CHILD(t,0) = value;
+  return t;
+}
+
+/* stmtem : exp_stmt | comp_stmt | if_stmt
+ *        | while_stmt | return_stmt
+ * A compound statement is a list of its own,
+ * which the enclosing list takes whole
+ */
+static NodeList statement( Parser * p )
+{ NodeList list = newList(NONODE);
+  Node t;
+  if (! enter(p)) return list;
+  switch (peek(p))
+  { case LKEY: list = compound(p); break;
+    case IF: list = newList(selection(p)); break;
+    case WHILE: list = newList(iteration(p)); break;
+    case RETURN: list = newList(jump(p)); break;
+    case SEMI: advance(p); break;
+    default:
+      t = expression(p);
+      match(p,SEMI);
+      list = newList(t);
+  }
+  leave(p);
+  return list;
+}
+
+/* params : param_list | VOID, where
+ * param : type_id id | type_id id LBRACKETS RBRACKETS
+ */
+static Node parameter( Parser * p, Node type )
+{ Node name = identifier(p);
+  if (p->failed) return NONODE;
+  CHILD(type,0) = name;
+  if (peek(p) == LBRACKETS)
+  { advance(p);
+    match(p,RBRACKETS);
+  }
+  return type;
+}
+
+static Node parameters( Parser * p )
+{ NodeList list;
+  Node type, t;
+  if (peek(p) == VOID)
+  { /* VOID alone is an empty parameter list */
+    advance(p);
+    if (peek(p) == RPAREN) return NONODE;
+    type = typeNode(VOID);
+  }
+  else type = typeId(p);
+  list = newList(parameter(p,type));
+  while (! p->failed && (peek(p) == COMMA))
+  { advance(p);
+    type = typeId(p);
+    list = appendList(list,newList(parameter(p,type)));
+  }
+  if (p->failed) return NONODE;
+  t = newStmtNode(ParamsK);
+  CHILD(t,0) = list.head;
+  return t;
+}
+
+/* func_stmt after its type_id, id and LPAREN */
+static Node function( Parser * p, Node type, Node name )
+{ Node params = parameters(p);
+  NodeList body;
+  Node t;
+  if (! match(p,RPAREN)) return NONODE;
+  body = compound(p);
+  if (p->failed) return NONODE;
+  t = newStmtNode(FuncK);
+  ATTR(t).name = ATTR(name).name;
+  CHILD(t,1) = params;
+  CHILD(t,2) = body.head;
+  TYPE(t) = TYPE(type);
+  return t;
+}
+
+/* stmt : var_stmt | func_stmt */
+static Node declaration( Parser * p )
+{ Node type = typeId(p);
+  Node name = identifier(p);
+  if (p->failed) return NONODE;
+  if (peek(p) == LPAREN)
+  { advance(p);
+    return function(p,type,name);
+  }
+  return variable(p,type,name);
+}
+
+/* PROGRAM : stmt_seq, where each stmt is given
+ * to the declared procedure of the compilation,
+ * if any, instead of the tree, as in tiny.y
+ */
+static void program( Parser * p )
+{ Compilation * unit = p->unit;
+  NodeList list = newList(NONODE);
+  do
+  { Node t = declaration(p);
+    if (p->failed) return;
+    if (unit->declared != NULL)
+    { unit->declared(t);
+      t = NONODE;
+    }
+    list = appendList(list,newList(t));
+  } while ((peek(p) == INT) || (peek(p) == VOID));
+  /* bison reduces PROGRAM before it finds out
+   * whether the token after it ends the source
+   */
+  unit->syntaxTree = list.head;
+  match(p,ENDFILE);
+}
+
+int descentParse( Compilation * unit )
+{ Parser p;
+  memset(&p,0,sizeof(p));
+  p.unit = unit;
+  program(&p);
+  return p.failed;
+}
@@ -13,27 +13,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
-
-/* Yacc/Bison generates internally its own values
- * for the tokens. Other files can access these values
- * by including the tab.h file generated using the
- * Yacc/Bison option -d ("generate header")
- *
- * The YYPARSER flag prevents inclusion of the tab.h
- * into the Yacc/Bison output itself
- */
-
-#ifndef YYPARSER
-
-/* the name of the following file may change */
-#include "tiny.tab.h"
-
-/* ENDFILE is implicitly defined by Yacc/Bison,
- * and not included in the tab.h file
- */
-#define ENDFILE 0
-
-#endif
+#include "arena.h"
 
 #ifndef FALSE
 #define FALSE 0
@@ -51,11 +31,20 @@
  */
 typedef int TokenType;
 
-extern FILE* source; /* source code text file */
-extern FILE* listing; /* listing output text file */
-extern FILE* code; /* code text file for TM simulator */
+/* THREAD gives every thread its own copy of a
+ * global variable, so that separate threads can
+ * compile separate files at the same time
+ */
+#define THREAD __thread
+
+extern THREAD FILE* source; /* source code text file */
+extern THREAD FILE* listing; /* listing output text file */
+extern THREAD FILE* code; /* code text file for TM simulator */
 
-extern int lineno; /* source line number for listing */
+/* source offset of the last token read; lineOf
+ * turns an offset into a line number
+ */
+extern THREAD unsigned position;
 
 /**************************************************/
 /***********   Syntax tree for parsing ************/
@@ -70,19 +59,170 @@ typedef enum {Void,Integer,Boolean} ExpType;
 
 #define MAXCHILDREN 3
 
+/* set COMPACTAST to TRUE to keep the syntax tree
+ * in per-field arrays indexed by 32-bit node
+ * numbers instead of in separate records
+ */
+#ifndef COMPACTAST
+#define COMPACTAST FALSE
+#endif
+
+/* NodeAttr is the attribute of a node */
+typedef union
+   { TokenType op;
+     int val;
+     char * name;
+   } NodeAttr;
+
+#if COMPACTAST
+/* A Node is the index of its fields in the
+ * arrays of the TreeStore of the current
+ * compilation; index 0 is no node
+ */
+typedef unsigned Node;
+#define NONODE 0
+
+typedef struct
+   { unsigned char * nodekind; /* NodeKind */
+     unsigned char * kind;     /* StmtKind or ExpKind */
+     unsigned char * type;     /* ExpType, for type checking of exps */
+     unsigned char * seen;     /* already_seem */
+     unsigned * pos;           /* source offset, see lineOf */
+     Node (* child)[MAXCHILDREN];
+     Node * sibling;
+     NodeAttr * attr;
+     struct SymbolRec ** symbol; /* record of the name, set by buildSymtab */
+     unsigned long count; /* nodes in use, counting index 0 */
+     unsigned long size;  /* nodes allocated */
+   } TreeStore;
+
+/* The fields of node t, as lvalues. The arrays
+ * move when a node is made, so the right side of
+ * an assignment to a field must not make one
+ */
+#define NODEKIND(t) (compilation->tree.nodekind[t])
+#define STMTKIND(t) (compilation->tree.kind[t])
+#define EXPKIND(t)  (compilation->tree.kind[t])
+#define TYPE(t)     (compilation->tree.type[t])
+#define SEEN(t)     (compilation->tree.seen[t])
+#define POS(t)      (compilation->tree.pos[t])
+#define CHILD(t,i)  (compilation->tree.child[t][i])
+#define SIBLING(t)  (compilation->tree.sibling[t])
+#define ATTR(t)     (compilation->tree.attr[t])
+#define SYMBOL(t)   (compilation->tree.symbol[t])
+#else
 typedef struct treeNode
    { struct treeNode * child[MAXCHILDREN];
      struct treeNode * sibling;
-     int lineno;
+     unsigned pos; /* source offset, see lineOf */
      int already_seem;
      NodeKind nodekind;
      union { StmtKind stmt; ExpKind exp;} kind;
-     union { TokenType op;
-             int val;
-             char * name; } attr;
+     NodeAttr attr;
      ExpType type; /* for type checking of exps */
+     struct SymbolRec * symbol; /* record of the name, set by buildSymtab */
    } TreeNode;
 
+/* A Node is the address of its record */
+typedef TreeNode * Node;
+#define NONODE NULL
+
+/* The fields of node t, as lvalues */
+#define NODEKIND(t) ((t)->nodekind)
+#define STMTKIND(t) ((t)->kind.stmt)
+#define EXPKIND(t)  ((t)->kind.exp)
+#define TYPE(t)     ((t)->type)
+#define SEEN(t)     ((t)->already_seem)
+#define POS(t)      ((t)->pos)
+#define CHILD(t,i)  ((t)->child[i])
+#define SIBLING(t)  ((t)->sibling)
+#define ATTR(t)     ((t)->attr)
+#define SYMBOL(t)   ((t)->symbol)
+#endif
+
+/* NodeList keeps both ends of a sibling chain
+ * while the parser is building it, so that
+ * appending to the chain takes constant time
+ */
+typedef struct
+   { Node head;
+     Node tail;
+   } NodeList;
+
+/**************************************************/
+/***********   State of a compilation  ************/
+/**************************************************/
+
+/* Compilation holds everything the compilation of
+ * one source file keeps between calls: the state
+ * of the scanner and parser and the tables of the
+ * tree, name and symbol table modules. The modules
+ * work on the current compilation of the thread
+ * calling them
+ */
+typedef struct
+   { /* scanner and parser (tiny.l, tiny.y) */
+     void * scanner; /* reentrant flex scanner */
+     TokenType token; /* last token read */
+     char * tokenString; /* its lexeme, valid until the next token */
+     size_t tokenLength; /* length of the lexeme */
+     Node syntaxTree; /* result of the parse */
+     int parsed; /* TRUE once the whole source is parsed and accepted */
+     double parseSeconds; /* time parse spent in the parser itself */
+     struct TokenArrayRec * tokens; /* tokens.c, NULL unless scanned first */
+     struct LexerRec * lexer; /* pipeline.c, NULL unless scanned by a thread */
+     struct yypstate * parser; /* push parser of a fed source */
+     /* takes each top-level declaration once parsed, if not NULL,
+      * leaving it out of syntaxTree */
+     void (* declared) (Node);
+     /* syntax tree storage (util.c) */
+#if COMPACTAST
+     TreeStore tree; /* owns every tree node */
+#endif
+     Arena treeArena; /* owns every tree node unless COMPACTAST */
+     unsigned long nodeCount;
+     /* stored names (intern.c) */
+     char ** names; /* hash table, NULL for empty slots */
+     unsigned long namesSize;
+     unsigned long namesCount;
+     Arena nameArena; /* owns the characters of every name */
+     /* symbol table (symtab.c) */
+     struct ScopeRec * globalScope;
+     struct ScopeRec * currentScope;
+     struct ScopeRec * lastScope;
+     /* semantic analysis (analyze.c) */
+     int location; /* counter for variable memory locations */
+     int main_already_seem;
+     unsigned long visits; /* nodes visited by the traversals */
+     double checkSeconds; /* time typeCheck took */
+   } Compilation;
+
+/* compilation is the current compilation of the
+ * thread, set by newCompilation
+ */
+extern THREAD Compilation * compilation;
+
+/* Yacc/Bison generates internally its own values
+ * for the tokens. Other files can access these values
+ * by including the tab.h file generated using the
+ * Yacc/Bison option -d ("generate header")
+ *
+ * The YYPARSER flag prevents inclusion of the tab.h
+ * into the Yacc/Bison output itself
+ */
+
+#ifndef YYPARSER
+
+/* the name of the following file may change */
+#include "tiny.tab.h"
+
+/* ENDFILE is implicitly defined by Yacc/Bison,
+ * and not included in the tab.h file
+ */
+#define ENDFILE 0
+
+#endif
+
 /**************************************************/
 /***********   Flags for tracing       ************/
 /**************************************************/
@@ -115,6 +255,59 @@ extern int TraceAnalyze;
  */
 extern int TraceCode;
 
+/* TraceAlloc = TRUE causes the number and size of
+ * tree nodes, the names and arena bytes allocated
+ * for the program, and the time the type check
+ * took to walk the tree, to be printed to the
+ * listing file
+ */
+extern int TraceAlloc;
+
+/* SymtabStats = TRUE causes the number of nodes
+ * the analysis visited, the time it took, and the
+ * load factor and probe length histogram of the
+ * symbol table to be printed to the listing file
+ * after analysis
+ */
+extern int SymtabStats;
+
+/* FusedAnalysis = TRUE makes the analyzer build
+ * the symbol table and check types in a single
+ * traversal instead of one traversal for each
+ */
+extern int FusedAnalysis;
+
+/* PreLex = TRUE causes the whole source to be
+ * scanned into a token array before it is parsed
+ */
+extern int PreLex;
+
+/* Pipeline = TRUE causes the source to be scanned
+ * by a thread of its own while it is parsed
+ */
+extern int Pipeline;
+
+/* Streaming = TRUE causes the source to be fed to
+ * the parser a part at a time and each top-level
+ * declaration to be analyzed and freed once it is
+ * parsed, so that the memory a compilation needs
+ * does not grow with the source
+ */
+extern int Streaming;
+
+/* ParseTime = TRUE causes the time parse spent
+ * in the parser itself, without scanning ahead
+ * or starting a lexer thread, to be printed to
+ * stderr for each file
+ */
+extern int ParseTime;
+
+/* SyntaxOnly = TRUE causes the source only to be
+ * checked for syntax errors: the parser builds no
+ * tree and nothing but the errors is listed
+ */
+extern int SyntaxOnly;
+
 /* Error = TRUE prevents further passes if an error occurs */
-extern int Error;
+extern THREAD int Error;
 #endif
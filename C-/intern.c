@@ -0,0 +1,136 @@
+/****************************************************/
+/* File: intern.c                                   */
+/* Identifier interning implementation              */
+/* for the CMINUS compiler                          */
+/* Names are kept in an open addressing hash table  */
+/* with linear probing that doubles when half full  */
+/* Each name is hashed eight bytes at a time and    */
+/* the hash is stored in front of the name          */
+/****************************************************/
+
+#include "globals.h"
+#include "intern.h"
+#include "arena.h"
+#include "scan.h"
+
+/* INITSIZE is the initial number of slots
+ * in the table (a power of two)
+ */
+#define INITSIZE 256
+
+/* MULTIPLIER is an odd 64 bit constant used to
+ * mix each word into the hash
+ */
+#define MULTIPLIER 0x9e3779b97f4a7c15ULL
+
+/* Function hashString returns the hash of the
+ * first len characters of s: each 8 byte word is
+ * folded in with a rotate, xor and multiply, and
+ * the final mix spreads the high bits into the
+ * low bits used to index power of two tables
+ */
+unsigned hashString( const char * s, size_t len )
+{ unsigned long long temp = len * MULTIPLIER;
+  unsigned long long word;
+  while (len >= 8)
+  { memcpy(&word,s,8);
+    temp = ((temp << 5 | temp >> 59) ^ word) * MULTIPLIER;
+    s += 8;
+    len -= 8;
+  }
+  if (len > 0)
+  { word = 0;
+    memcpy(&word,s,len);
+    temp = ((temp << 5 | temp >> 59) ^ word) * MULTIPLIER;
+  }
+  temp ^= temp >> 32;
+  temp *= MULTIPLIER;
+  return (unsigned) (temp >> 32);
+}
+
+/* Procedure grow doubles the table and reinserts
+ * every stored name
+ */
+static int grow(void)
+{ char ** table = compilation->names;
+  unsigned long size = compilation->namesSize;
+  unsigned long newSize = size ? 2*size : INITSIZE;
+  char ** newTable = (char **) calloc(newSize,sizeof(char *));
+  unsigned long i;
+  if (newTable == NULL) return FALSE;
+  for (i=0;i<size;i++)
+    if (table[i] != NULL)
+    { unsigned long j = internHash(table[i]) & (newSize-1);
+      while (newTable[j] != NULL) j = (j+1) & (newSize-1);
+      newTable[j] = table[i];
+    }
+  free(table);
+  compilation->names = newTable;
+  compilation->namesSize = newSize;
+  return TRUE;
+}
+
+/* Function internString returns the unique stored
+ * copy of s; equal strings always yield the same
+ * pointer until the next internRelease
+ */
+char * internString( const char * s )
+{ if (s==NULL) return NULL;
+  return internSlice(s,strlen(s));
+}
+
+/* Function internSlice returns the unique stored
+ * copy of the first len characters of s, which
+ * need not be null terminated
+ */
+char * internSlice( const char * s, size_t len )
+{ unsigned long i, mask;
+  unsigned h;
+  InternHeader * header;
+  char ** table;
+  char * t;
+  if (2*(compilation->namesCount+1) > compilation->namesSize && !grow())
+  { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+    return NULL;
+  }
+  table = compilation->names;
+  mask = compilation->namesSize - 1;
+  h = hashString(s,len);
+  i = h & mask;
+  while (table[i] != NULL)
+  { if ((internHash(table[i]) == h) && (internLength(table[i]) == len)
+        && (memcmp(table[i],s,len) == 0))
+      return table[i];
+    i = (i+1) & mask;
+  }
+  header = arenaAlloc(&compilation->nameArena,sizeof(InternHeader)+len+1);
+  if (header==NULL)
+  { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+    return NULL;
+  }
+  header->hash = h;
+  header->length = (unsigned) len;
+  t = (char *) (header+1);
+  memcpy(t,s,len);
+  t[len] = '\0';
+  table[i] = t;
+  compilation->namesCount++;
+  return t;
+}
+
+/* Function internCount returns the number of
+ * distinct names stored in the table
+ */
+unsigned long internCount(void)
+{ return compilation->namesCount;
+}
+
+/* Procedure internRelease discards every stored
+ * name at once
+ */
+void internRelease(void)
+{ free(compilation->names);
+  compilation->names = NULL;
+  compilation->namesSize = compilation->namesCount = 0;
+  arenaRelease(&compilation->nameArena);
+}
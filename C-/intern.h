@@ -0,0 +1,55 @@
+/****************************************************/
+/* File: intern.h                                   */
+/* Identifier interning for the CMINUS compiler:    */
+/* each distinct name is stored exactly once, so    */
+/* names can be compared by pointer                 */
+/****************************************************/
+
+#ifndef _INTERN_H_
+#define _INTERN_H_
+
+#include <stddef.h>
+
+/* Every stored name is preceded by a header
+ * holding its hash and length, computed once
+ * when the name is first interned
+ */
+typedef struct
+   { unsigned hash;
+     unsigned length;
+   } InternHeader;
+
+/* internHash and internLength read the header
+ * of a name returned by internString
+ */
+#define internHash(s) (((const InternHeader *)(s))[-1].hash)
+#define internLength(s) (((const InternHeader *)(s))[-1].length)
+
+/* Function hashString returns the hash of the
+ * first len characters of s
+ */
+unsigned hashString( const char * s, size_t len );
+
+/* Function internString returns the unique stored
+ * copy of s; equal strings always yield the same
+ * pointer until the next internRelease
+ */
+char * internString( const char * s );
+
+/* Function internSlice returns the unique stored
+ * copy of the first len characters of s, which
+ * need not be null terminated
+ */
+char * internSlice( const char * s, size_t len );
+
+/* Function internCount returns the number of
+ * distinct names stored in the table
+ */
+unsigned long internCount(void);
+
+/* Procedure internRelease discards every stored
+ * name at once
+ */
+void internRelease(void);
+
+#endif
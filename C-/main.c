@@ -6,6 +6,9 @@
 /****************************************************/
 
 #include "globals.h"
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
 
 /* set NO_PARSE to TRUE to get a scanner-only compiler */
 #define NO_PARSE FALSE
@@ -18,12 +21,12 @@
 #define NO_CODE TRUE
 
 #include "util.h"
-#if NO_PARSE
 #include "scan.h"
-#else
+#if !NO_PARSE
 #include "parse.h"
 #if !NO_ANALYZE
 #include "analyze.h"
+#include "symtab.h"
 #if !NO_CODE
 #include "cgen.h"
 #endif
@@ -31,10 +34,11 @@
 #endif
 
 /* allocate global variables */
-int lineno = 0;
-FILE * source;
-FILE * listing;
-FILE * code;
+THREAD unsigned position = 0;
+THREAD FILE * source;
+THREAD FILE * listing;
+THREAD FILE * code;
+THREAD Compilation * compilation = NULL;
 
 /* allocate and set tracing flags */
 int EchoSource = FALSE;
@@ -42,44 +46,194 @@ int TraceScan = FALSE;
 int TraceParse = TRUE;
 int TraceAnalyze = TRUE;
 int TraceCode = FALSE;
+int TraceAlloc = FALSE;
+int SymtabStats = FALSE;
+int FusedAnalysis = FALSE;
+int PreLex = FALSE;
+int Pipeline = FALSE;
+int Streaming = FALSE;
+int SyntaxOnly = FALSE;
+int ParseTime = FALSE;
 
-int Error = FALSE;
+THREAD int Error = FALSE;
 
-int main( int argc, char * argv[] )
-{ TreeNode * syntaxTree;
-  char pgm[120]; /* source code file name */
-  if (argc != 2)
-    { fprintf(stderr,"usage: %s <filename>\n",argv[0]);
-      exit(1);
-    }
-  strcpy(pgm,argv[1]) ;
+/* status of the compilation of one file */
+#define COMPILED 0  /* no errors */
+#define FAILED 1    /* syntax or semantic errors */
+#define NOTFOUND 2  /* the file could not be opened */
+#define NOTREAD 3   /* the file could not be read */
+
+static const char * statusName[] = { "ok", "errors", "not found", "not read" };
+
+/* Function secondsSince returns the time elapsed
+ * since start
+ */
+static double secondsSince( struct timespec * start )
+{ struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* MAXNAME is the maximum length of a file name */
+#define MAXNAME 1024
+
+/* Procedure sourceName copies name to pgm,
+ * adding the .tny suffix if it has none
+ */
+static void sourceName( char * pgm, const char * name )
+{ strncpy(pgm,name,MAXNAME);
+  pgm[MAXNAME] = '\0';
   if (strchr (pgm, '.') == NULL)
      strcat(pgm,".tny");
+}
+
+#if !NO_PARSE
+/* STREAMCHUNK is the number of bytes read from
+ * the source at a time in streaming mode
+ */
+#define STREAMCHUNK 65536
+
+/* Procedure compileDeclaration compiles the
+ * top-level declaration t as soon as it is
+ * parsed in streaming mode and then frees it,
+ * with the lines behind it, so that only one
+ * declaration is held at a time
+ */
+static void compileDeclaration( Node t )
+{ if (TraceParse) printTree(t);
+#if !NO_ANALYZE
+  analyzeDeclaration(t);
+#endif
+  freeTree();
+  /* the nodes made from now on start at the
+   * lookahead token or after it
+   */
+  forgetLines(position);
+}
+
+/* Function streamSource feeds the source file
+ * to the parser in parts of STREAMCHUNK bytes,
+ * as they would arrive through a pipe, and
+ * returns FALSE after a syntax error or when
+ * the file cannot be read
+ */
+static int streamSource( FILE * file )
+{ char chunk[STREAMCHUNK];
+  size_t n;
+  if (! beginParse())
+  { fprintf(listing,"Out of memory error\n");
+    Error = TRUE;
+    return FALSE;
+  }
+  compilation->declared = compileDeclaration;
+  do n = fread(chunk,1,STREAMCHUNK,file);
+  while (! ferror(file) && parseChunk(chunk,n));
+  return ! ferror(file) && compilation->parsed;
+}
+#endif
+
+/* Function compile compiles the source file
+ * name and returns its status, writing the
+ * listing to out and other diagnostics to diag.
+ * All compiler state is created for the file
+ * and released before returning, so files can
+ * be compiled one after the other, or at the
+ * same time by separate threads
+ */
+static int compile( const char * name, FILE * out, FILE * diag )
+{ Node syntaxTree;
+  int parsed = FALSE;
+  char pgm[MAXNAME+5]; /* source code file name */
+  int status;
+  int failure;
+  sourceName(pgm,name);
   source = fopen(pgm,"r");
   if (source==NULL)
-  { fprintf(stderr,"File %s not found\n",pgm);
-    exit(1);
+  { fprintf(diag,"File %s not found\n",pgm);
+    return NOTFOUND;
+  }
+  listing = out;
+  if (! SyntaxOnly) fprintf(listing,"\nC- COMPILATION: %s\n",pgm);
+  if (newCompilation(Streaming && ! SyntaxOnly ? NULL : source,&failure) == NULL)
+  { if (failure == READERROR)
+      fprintf(diag,"File %s cannot be read\n",pgm);
+    else if (failure == TOOLARGE)
+      fprintf(diag,"File %s is too large\n",pgm);
+    else
+      fprintf(diag,"Out of memory error reading %s\n",pgm);
+    fclose(source);
+    return NOTREAD;
   }
-  listing = stdout; /* send listing to screen */
-  fprintf(listing,"\nC- COMPILATION: %s\n",pgm);
 #if NO_PARSE
-  while (getToken()!=ENDFILE);
+  { YYSTYPE value;
+    while (getToken(compilation,&value)!=ENDFILE);
+  }
 #else
-  syntaxTree = parse();
-  if (TraceParse) {
-    fprintf(listing,"\nSyntax tree:\n");
-    printTree(syntaxTree);
+  if (SyntaxOnly)
+  { /* the parse builds no tree to list or analyze */
+    syntaxTree = parse();
   }
+  else if (Streaming)
+  { /* each declaration is listed, analyzed and
+     * freed as soon as it is parsed
+     */
+    if (TraceParse) fprintf(listing,"\nSyntax tree:\n");
 #if !NO_ANALYZE
-  if (! Error)
-  { if (TraceAnalyze) fprintf(listing,"\nBuilding Symbol Table...\n");
-    buildSymtab(syntaxTree);
-    if (TraceAnalyze) fprintf(listing,"\nChecking Types...\n");
-    typeCheck(syntaxTree);
-    if (TraceAnalyze) fprintf(listing,"\nType Checking Finished\n");
+    if (TraceAnalyze) fprintf(listing,"\nAnalyzing...\n");
+#endif
+    syntaxTree = NONODE;
+    parsed = streamSource(source);
+  }
+  else
+  { syntaxTree = parse();
+    if (TraceParse) {
+      fprintf(listing,"\nSyntax tree:\n");
+      printTree(syntaxTree);
+    }
+  }
+  /* a streamed source is parsed as it is read */
+  if (ParseTime && (SyntaxOnly || ! Streaming))
+    fprintf(diag,"%s parsed in %.3f s\n",pgm,compilation->parseSeconds);
+#if !NO_ANALYZE
+  if (Streaming)
+  { if (parsed)
+    { finishAnalysis();
+      if (TraceAnalyze) fprintf(listing,"\nAnalysis Finished\n");
+      if (SymtabStats)
+      { /* the analysis is interleaved with the parse */
+        fprintf(listing,"\nAnalysis: %lu node visits\n",compilation->visits);
+        printSymTabStats(listing);
+      }
+    }
+  }
+  else if (! Error && ! SyntaxOnly)
+  { struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC,&start);
+    if (FusedAnalysis)
+    { if (TraceAnalyze) fprintf(listing,"\nAnalyzing...\n");
+      analyze(syntaxTree);
+      if (TraceAnalyze) fprintf(listing,"\nAnalysis Finished\n");
+    }
+    else
+    { if (TraceAnalyze) fprintf(listing,"\nBuilding Symbol Table...\n");
+      buildSymtab(syntaxTree);
+      if (TraceAnalyze) fprintf(listing,"\nChecking Types...\n");
+      { struct timespec check;
+        clock_gettime(CLOCK_MONOTONIC,&check);
+        typeCheck(syntaxTree);
+        compilation->checkSeconds = secondsSince(&check);
+      }
+      if (TraceAnalyze) fprintf(listing,"\nType Checking Finished\n");
+    }
+    if (SymtabStats)
+    { fprintf(listing,"\nAnalysis: %lu node visits in %.3f s\n",
+              compilation->visits,secondsSince(&start));
+      printSymTabStats(listing);
+    }
   }
 #if !NO_CODE
-  if (! Error)
+  /* a streamed source leaves no tree behind */
+  if (! Error && ! Streaming && ! SyntaxOnly)
   { char * codefile;
     int fnlen = strcspn(pgm,".");
     codefile = (char *) calloc(fnlen+4, sizeof(char));
@@ -92,10 +246,349 @@ int main( int argc, char * argv[] )
     }
     codeGen(syntaxTree,codefile);
     fclose(code);
+    free(codefile);
   }
 #endif
 #endif
+  if (TraceAlloc) printAllocStats();
 #endif
+  status = Error ? FAILED : COMPILED;
+  /* a streamed source is read while it is parsed */
+  if (ferror(source))
+  { fprintf(diag,"File %s cannot be read\n",pgm);
+    status = NOTREAD;
+  }
+  freeCompilation(compilation);
   fclose(source);
-  return 0;
+  return status;
+}
+
+/* The record of each file to compile. In
+ * parallel mode the listing and diagnostics of
+ * the file are kept in memory until every file
+ * before it has been written out
+ */
+typedef struct
+   { char * name;
+     long size;     /* bytes in the file, 0 if not found */
+     int status;
+     int done;      /* TRUE once the file is compiled */
+     char * text;   /* buffered listing */
+     size_t textLen;
+     char * diag;   /* buffered diagnostics */
+     size_t diagLen;
+   } Unit;
+
+/* the files to compile, in input order */
+static Unit * units = NULL;
+static int unitCount = 0;
+static int unitSize = 0;
+
+/* counters of the files compiled, by status */
+static unsigned long count[4];
+
+/* batch = TRUE causes the status of every file
+ * to be reported on stderr
+ */
+static int batch = FALSE;
+
+/* Function fileSize returns the size of the
+ * source file name, 0 if it is not found
+ */
+static long fileSize( const char * name )
+{ char pgm[MAXNAME+5];
+  struct stat st;
+  sourceName(pgm,name);
+  return (stat(pgm,&st) == 0) ? (long) st.st_size : 0;
+}
+
+/* Procedure addUnit appends the file name to
+ * the files to compile
+ */
+static void addUnit( const char * name )
+{ Unit * u;
+  if (unitCount == unitSize)
+  { unitSize = unitSize ? 2*unitSize : 64;
+    units = (Unit *) realloc(units,unitSize*sizeof(Unit));
+    if (units == NULL)
+    { fprintf(stderr,"Out of memory\n");
+      exit(1);
+    }
+  }
+  u = &units[unitCount++];
+  memset(u,0,sizeof(Unit));
+  u->name = (char *) malloc(strlen(name)+1);
+  if (u->name == NULL)
+  { fprintf(stderr,"Out of memory\n");
+    exit(1);
+  }
+  strcpy(u->name,name);
+}
+
+/* Procedure readList adds every file named in
+ * list, one name per line; blank lines are
+ * ignored
+ */
+static void readList( FILE * list )
+{ char line[MAXNAME+2];
+  while (fgets(line,sizeof(line),list) != NULL)
+  { size_t len = strcspn(line,"\r\n");
+    if ((line[len] == '\0') && (len == MAXNAME+1))
+    { fprintf(stderr,"file name too long: %.40s...\n",line);
+      while (fgets(line,sizeof(line),list) != NULL)
+        if (strchr(line,'\n') != NULL) break;
+      count[NOTFOUND]++;
+      continue;
+    }
+    while ((len > 0) && isspace((unsigned char) line[len-1])) len--;
+    line[len] = '\0';
+    if (len > 0) addUnit(line);
+  }
+}
+
+/* Procedure compileAll compiles every file in
+ * input order on the calling thread
+ */
+static void compileAll(void)
+{ int i;
+  for (i=0;i<unitCount;i++)
+  { Unit * u = &units[i];
+    u->status = compile(u->name,stdout,stderr);
+    count[u->status]++;
+    if (batch) fprintf(stderr,"%s: %s\n",u->name,statusName[u->status]);
+  }
+}
+
+/**************************************************/
+/***********   Parallel compilation    ************/
+/**************************************************/
+
+/* Each worker thread owns a queue of files,
+ * largest first. A worker takes files from the
+ * front of its own queue; once that is empty it
+ * steals from the back of the other queues, so
+ * that workers left with small files help those
+ * still holding large ones
+ */
+typedef struct
+   { pthread_mutex_t lock;
+     int * jobs;  /* indices in units */
+     int head;    /* next file of the owner */
+     int tail;    /* one past the last file */
+   } Queue;
+
+static Queue * queues;
+static int workers;
+
+/* doneLock and doneCond guard the done flags
+ * of the units, which the main thread waits on
+ * to write the units out in input order
+ */
+static pthread_mutex_t doneLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t doneCond = PTHREAD_COND_INITIALIZER;
+
+/* Function takeJob returns the next file for
+ * worker w, or -1 when every queue is empty
+ */
+static int takeJob( int w )
+{ int k, job = -1;
+  for (k=0;(k<workers) && (job<0);k++)
+  { Queue * q = &queues[(w+k) % workers];
+    pthread_mutex_lock(&q->lock);
+    if (q->head < q->tail)
+      job = (k == 0) ? q->jobs[q->head++] : q->jobs[--q->tail];
+    pthread_mutex_unlock(&q->lock);
+  }
+  return job;
+}
+
+/* Function worker is the body of each worker
+ * thread: it compiles files into memory until
+ * no file is left
+ */
+static void * worker( void * arg )
+{ int w = (int) (long) arg;
+  int job;
+  while ((job = takeJob(w)) >= 0)
+  { Unit * u = &units[job];
+    FILE * out = open_memstream(&u->text,&u->textLen);
+    FILE * diag = open_memstream(&u->diag,&u->diagLen);
+    if ((out == NULL) || (diag == NULL))
+    { fprintf(stderr,"Out of memory\n");
+      exit(1);
+    }
+    u->status = compile(u->name,out,diag);
+    if (batch) fprintf(diag,"%s: %s\n",u->name,statusName[u->status]);
+    fclose(out);
+    fclose(diag);
+    pthread_mutex_lock(&doneLock);
+    u->done = TRUE;
+    pthread_cond_broadcast(&doneCond);
+    pthread_mutex_unlock(&doneLock);
+  }
+  return NULL;
+}
+
+/* Function bySize orders files largest first,
+ * in input order among files of equal size
+ */
+static int bySize( const void * a, const void * b )
+{ const Unit * x = &units[*(const int *) a];
+  const Unit * y = &units[*(const int *) b];
+  if (x->size != y->size) return (x->size < y->size) ? 1 : -1;
+  return *(const int *) a - *(const int *) b;
+}
+
+/* Procedure compileParallel compiles every file
+ * on n worker threads and writes the listings
+ * and diagnostics out in input order as soon as
+ * they are available
+ */
+static void compileParallel( int n )
+{ pthread_t * threads;
+  int * order;
+  int i;
+  if (n > unitCount) n = unitCount;
+  workers = n;
+  order = (int *) malloc(unitCount*sizeof(int));
+  queues = (Queue *) calloc(n,sizeof(Queue));
+  threads = (pthread_t *) malloc(n*sizeof(pthread_t));
+  if ((order == NULL) || (queues == NULL) || (threads == NULL))
+  { fprintf(stderr,"Out of memory\n");
+    exit(1);
+  }
+  for (i=0;i<unitCount;i++)
+  { units[i].size = fileSize(units[i].name);
+    order[i] = i;
+  }
+  qsort(order,unitCount,sizeof(int),bySize);
+  /* deal the files out in turn, so that every
+   * queue stays sorted largest first
+   */
+  for (i=0;i<n;i++)
+  { pthread_mutex_init(&queues[i].lock,NULL);
+    queues[i].jobs = (int *) malloc((unitCount/n+1)*sizeof(int));
+    if (queues[i].jobs == NULL)
+    { fprintf(stderr,"Out of memory\n");
+      exit(1);
+    }
+  }
+  for (i=0;i<unitCount;i++)
+  { Queue * q = &queues[i % n];
+    q->jobs[q->tail++] = order[i];
+  }
+  for (i=0;i<n;i++)
+    if (pthread_create(&threads[i],NULL,worker,(void *) (long) i) != 0)
+    { fprintf(stderr,"Unable to create worker thread\n");
+      exit(1);
+    }
+  for (i=0;i<unitCount;i++)
+  { Unit * u = &units[i];
+    pthread_mutex_lock(&doneLock);
+    while (! u->done) pthread_cond_wait(&doneCond,&doneLock);
+    pthread_mutex_unlock(&doneLock);
+    fwrite(u->text,1,u->textLen,stdout);
+    fwrite(u->diag,1,u->diagLen,stderr);
+    free(u->text);
+    free(u->diag);
+    u->text = u->diag = NULL;
+    count[u->status]++;
+  }
+  for (i=0;i<n;i++)
+  { pthread_join(threads[i],NULL);
+    pthread_mutex_destroy(&queues[i].lock);
+    free(queues[i].jobs);
+  }
+  free(threads);
+  free(queues);
+  free(order);
+}
+
+/* Procedure printThroughput prints to stderr
+ * the rate at which the files were checked in
+ * syntax-only mode, which took seconds
+ */
+static void printThroughput( double seconds )
+{ double bytes = 0.0;
+  int i;
+  for (i=0;i<unitCount;i++)
+    bytes += (double) fileSize(units[i].name);
+  fprintf(stderr,"%.0f bytes in %.3f s: %.1f MB/s\n",bytes,seconds,
+          seconds > 0.0 ? bytes / 1e6 / seconds : 0.0);
+}
+
+int main( int argc, char * argv[] )
+{ int arg = 1;
+  int jobs = 1;
+  struct timespec start;
+  int i;
+  while ((arg < argc) && (argv[arg][0] == '-') && (argv[arg][1] != '\0'))
+  { if (strcmp(argv[arg],"--symtab-stats") == 0)
+      SymtabStats = TRUE;
+    else if (strcmp(argv[arg],"--fused-analysis") == 0)
+      FusedAnalysis = TRUE;
+    else if (strcmp(argv[arg],"--prelex") == 0)
+      PreLex = TRUE;
+    else if (strcmp(argv[arg],"--pipeline") == 0)
+      Pipeline = TRUE;
+    else if (strcmp(argv[arg],"--stream") == 0)
+      Streaming = TRUE;
+    else if (strcmp(argv[arg],"-fsyntax-only") == 0)
+      SyntaxOnly = TRUE;
+    else if (strcmp(argv[arg],"--parse-time") == 0)
+      ParseTime = TRUE;
+    else if (strcmp(argv[arg],"--alloc-stats") == 0)
+      TraceAlloc = TRUE;
+    else if (strncmp(argv[arg],"-j",2) == 0)
+    { const char * n = argv[arg]+2;
+      if ((*n == '\0') && (arg+1 < argc)) n = argv[++arg];
+      jobs = atoi(n);
+      if (jobs < 1)
+      { fprintf(stderr,"invalid number of jobs %s\n",n);
+        exit(1);
+      }
+    }
+    else
+    { fprintf(stderr,"unknown option %s\n",argv[arg]);
+      exit(1);
+    }
+    arg++;
+  }
+  if (arg == argc)
+    { fprintf(stderr,"usage: %s [--symtab-stats] [--alloc-stats] [--fused-analysis] [--prelex] [--pipeline] [--stream] [-fsyntax-only] [--parse-time] [-j N] <filename>... | @<listfile> | -\n",argv[0]);
+      exit(1);
+    }
+  /* a list of files, a list file or a list on
+   * stdin is a batch; a single file is not
+   */
+  batch = (arg < argc-1) || (argv[arg][0] == '@') || (strcmp(argv[arg],"-") == 0);
+  for (; arg < argc; arg++)
+  { if (strcmp(argv[arg],"-") == 0)
+      readList(stdin);
+    else if (argv[arg][0] == '@')
+    { FILE * list = fopen(argv[arg]+1,"r");
+      if (list == NULL)
+      { fprintf(stderr,"File %s not found\n",argv[arg]+1);
+        count[NOTFOUND]++;
+        continue;
+      }
+      readList(list);
+      fclose(list);
+    }
+    else addUnit(argv[arg]);
+  }
+  clock_gettime(CLOCK_MONOTONIC,&start);
+  if ((jobs > 1) && (unitCount > 1))
+    compileParallel(jobs);
+  else
+    compileAll();
+  if (SyntaxOnly) printThroughput(secondsSince(&start));
+  for (i=0;i<unitCount;i++) free(units[i].name);
+  free(units);
+  if (batch)
+    fprintf(stderr,"%lu ok, %lu with errors, %lu not found, %lu not read\n",
+            count[COMPILED],count[FAILED],count[NOTFOUND],count[NOTREAD]);
+  /* a syntax check also fails on syntax errors */
+  return ((count[NOTFOUND] > 0) || (count[NOTREAD] > 0)
+          || (SyntaxOnly && (count[FAILED] > 0))) ? 1 : 0;
 }
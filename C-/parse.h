@@ -8,10 +8,64 @@
 #ifndef _PARSE_H_
 #define _PARSE_H_
 
+/* set HANDPARSE to TRUE to get a compiler that
+ * parses with the hand-written parser of
+ * descent.c instead of the bison parser of tiny.y
+ * (a fed source is always parsed by bison)
+ */
+#ifndef HANDPARSE
+#define HANDPARSE FALSE
+#endif
+
 /* Function parse returns the newly 
  * constructed syntax tree
  */
-TreeNode * parse(void);
+Node parse(void);
+
+/* Function parserToken returns the next token
+ * of the source of compilation unit for the
+ * parser, from its token array, its lexer
+ * thread or its scanner, and stores its semantic
+ * value in *value
+ */
+TokenType parserToken( Compilation * unit, YYSTYPE * value );
+
+/* Function yyerror reports a syntax error at
+ * the current token of compilation unit
+ */
+int yyerror( Compilation * unit, const char * message );
+
+/* Function descentParse parses the source of
+ * compilation unit as yyparse does, by recursive
+ * descent. It returns 0 if the source is parsed
+ * and 1 after a syntax error
+ */
+int descentParse( Compilation * unit );
+
+/* Function beginParse makes the parser of the
+ * current compilation parse a source fed to it
+ * with parseChunk instead of reading it. It
+ * returns FALSE if memory is exhausted
+ */
+int beginParse(void);
+
+/* Function parseChunk parses the length bytes at
+ * chunk, the next part of the source of the
+ * current compilation, as far as it holds
+ * complete lines; a length of 0 ends the source.
+ * Each top-level declaration is passed to the
+ * declared procedure of the compilation as soon
+ * as it is parsed. It returns TRUE while the
+ * parser wants more of the source and FALSE once
+ * the parse is over, leaving the parsed field of
+ * the compilation TRUE only if it was accepted
+ */
+int parseChunk(const char * chunk, size_t length);
+
+/* Procedure freeParser releases the parser of a
+ * fed source of compilation c
+ */
+void freeParser(Compilation * c);
 
 #endif
 
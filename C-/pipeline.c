@@ -0,0 +1,198 @@
+/****************************************************/
+/* File: pipeline.c                                 */
+/* Lexer thread implementation                      */
+/* for the CMINUS compiler                          */
+/****************************************************/
+
+#include "globals.h"
+#include "scan.h"
+#include "tokens.h"
+#include "pipeline.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+/* RINGSIZE is the number of tokens the ring
+ * buffer holds (a power of two)
+ */
+#define RINGSIZE 4096
+
+/* BATCH is the number of tokens each side takes
+ * or gives before it tells the other side, so
+ * that the shared counters are not written for
+ * every token
+ */
+#define BATCH 64
+
+/* LINE is the size of a cache line: the counters
+ * of each side are kept on lines of their own
+ */
+#define LINE 64
+
+/* The record of each token in the ring */
+typedef struct
+   { TokenType token;
+     unsigned offset; /* of the lexeme in the text */
+     unsigned length; /* bytes in the lexeme */
+   } Piped;
+
+/* The ring buffer between the lexer thread, the
+ * only one to write tokens, and the parser, the
+ * only one to read them. Each side counts the
+ * tokens it has passed and publishes its count
+ * with release stores; the other side reads it
+ * with acquire loads only when the count it saw
+ * last is used up
+ */
+typedef struct LexerRec
+   { Piped ring[RINGSIZE];
+     /* written by the lexer thread */
+     _Alignas(LINE) atomic_ulong tail; /* tokens given */
+     atomic_int parked; /* TRUE while it waits in pauseLexer */
+     atomic_int done;   /* TRUE once it has given ENDFILE */
+     /* written by the parser */
+     _Alignas(LINE) atomic_ulong head; /* tokens taken */
+     atomic_int pause;  /* TRUE to make it wait */
+     atomic_int stop;   /* TRUE to make it give up */
+     /* used by the parser only */
+     _Alignas(LINE) unsigned long next; /* next token to take */
+     unsigned long given; /* value of tail read last */
+     int ended;         /* TRUE once ENDFILE is taken */
+     Piped last;        /* the ENDFILE token */
+     const char * text; /* text the offsets refer to */
+     void * scanner;
+     pthread_t thread;
+   } Lexer;
+
+/* Procedure relax lets other threads run while
+ * one side waits for the other
+ */
+static void relax(void)
+{ sched_yield();
+}
+
+/* Function checkPause waits while the parser has
+ * paused the lexer thread. It returns TRUE if the
+ * lexer thread must give up
+ */
+static int checkPause( Lexer * l )
+{ if (atomic_load_explicit(&l->pause,memory_order_acquire))
+  { atomic_store_explicit(&l->parked,TRUE,memory_order_release);
+    while (atomic_load_explicit(&l->pause,memory_order_acquire))
+      relax();
+    atomic_store_explicit(&l->parked,FALSE,memory_order_release);
+  }
+  return atomic_load_explicit(&l->stop,memory_order_relaxed);
+}
+
+/* Function waitForRoom waits until the ring has
+ * room for one more token, when tail tokens have
+ * been given and the parser was last seen to
+ * have taken *taken. It returns FALSE if the
+ * lexer thread must give up
+ */
+static int waitForRoom( Lexer * l, unsigned long tail, unsigned long * taken )
+{ while (tail - *taken == RINGSIZE)
+  { *taken = atomic_load_explicit(&l->head,memory_order_acquire);
+    if (tail - *taken < RINGSIZE) break;
+    /* the parser may be waiting for a batch
+     * that is not full yet
+     */
+    atomic_store_explicit(&l->tail,tail,memory_order_release);
+    if (checkPause(l)) return FALSE;
+    relax();
+  }
+  return TRUE;
+}
+
+/* Function lexer is the body of the lexer thread:
+ * it scans tokens into the ring until ENDFILE or
+ * until the parser stops it
+ */
+static void * lexer( void * arg )
+{ Lexer * l = (Lexer *) arg;
+  unsigned long tail = 0;
+  unsigned long taken = 0; /* value of head read last */
+  TokenType token;
+  do
+  { Piped * p;
+    size_t length;
+    if (checkPause(l) || ! waitForRoom(l,tail,&taken)) break;
+    p = &l->ring[tail % RINGSIZE];
+    token = p->token = scanToken(l->scanner,&p->offset,&length);
+    p->length = (unsigned) length;
+    tail++;
+    if ((tail % BATCH == 0) || (token == ENDFILE))
+      atomic_store_explicit(&l->tail,tail,memory_order_release);
+  } while (token != ENDFILE);
+  atomic_store_explicit(&l->done,TRUE,memory_order_release);
+  return NULL;
+}
+
+int startLexer( Compilation * c )
+{ Lexer * l;
+  if (posix_memalign((void **) &l,LINE,sizeof(Lexer)) != 0) return FALSE;
+  memset(l,0,sizeof(Lexer));
+  l->text = scannerText(c->scanner);
+  l->scanner = c->scanner;
+  if (pthread_create(&l->thread,NULL,lexer,l) != 0)
+  { free(l);
+    return FALSE;
+  }
+  c->lexer = l;
+  return TRUE;
+}
+
+TokenType pipedToken( Compilation * c, YYSTYPE * value )
+{ Lexer * l = c->lexer;
+  Piped p;
+  if (l->ended)
+    p = l->last;
+  else
+  { while (l->next == l->given)
+    { l->given = atomic_load_explicit(&l->tail,memory_order_acquire);
+      if (l->next < l->given) break;
+      atomic_store_explicit(&l->head,l->next,memory_order_release);
+      relax();
+    }
+    p = l->ring[l->next % RINGSIZE];
+    l->next++;
+    if (l->next % BATCH == 0)
+      atomic_store_explicit(&l->head,l->next,memory_order_release);
+    /* stay on ENDFILE once it is reached */
+    if (p.token == ENDFILE)
+    { l->last = p;
+      l->ended = TRUE;
+    }
+  }
+  return setToken(c,p.token,l->text,p.offset,p.length,value);
+}
+
+void pauseLexer( Compilation * c )
+{ Lexer * l = c->lexer;
+  if (l == NULL) return;
+  atomic_store_explicit(&l->pause,TRUE,memory_order_release);
+  while (! atomic_load_explicit(&l->parked,memory_order_acquire)
+         && ! atomic_load_explicit(&l->done,memory_order_acquire))
+    relax();
+}
+
+void resumeLexer( Compilation * c )
+{ Lexer * l = c->lexer;
+  if (l == NULL) return;
+  atomic_store_explicit(&l->pause,FALSE,memory_order_release);
+  /* wait until it has seen it, so that another
+   * pause does not find it still parked
+   */
+  while (atomic_load_explicit(&l->parked,memory_order_acquire))
+    relax();
+}
+
+void stopLexer( Compilation * c )
+{ Lexer * l = c->lexer;
+  if (l == NULL) return;
+  atomic_store_explicit(&l->stop,TRUE,memory_order_relaxed);
+  pthread_join(l->thread,NULL);
+  free(l);
+  c->lexer = NULL;
+}
@@ -0,0 +1,44 @@
+/****************************************************/
+/* File: pipeline.h                                 */
+/* Lexer thread for the CMINUS compiler: the source */
+/* is scanned on a thread of its own that passes    */
+/* tokens to the parser through a ring buffer, so   */
+/* that scanning and parsing overlap                */
+/****************************************************/
+
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+/* Function startLexer starts a thread scanning
+ * the source of compilation c. It returns FALSE
+ * if the thread cannot be started
+ */
+int startLexer( Compilation * c );
+
+/* Function pipedToken returns the next token
+ * from the lexer thread of compilation c, like
+ * getToken does from the source: it stores its
+ * semantic value in *value, its lexeme (not null
+ * terminated) in c->tokenString and c->tokenLength
+ * and its offset in position
+ */
+TokenType pipedToken( Compilation * c, YYSTYPE * value );
+
+/* Procedure pauseLexer makes the lexer thread of
+ * compilation c, if any, wait between two tokens
+ * until resumeLexer is called, so that the text
+ * it scans can be read
+ */
+void pauseLexer( Compilation * c );
+
+/* Procedure resumeLexer lets the lexer thread of
+ * compilation c go on after pauseLexer
+ */
+void resumeLexer( Compilation * c );
+
+/* Procedure stopLexer stops the lexer thread of
+ * compilation c, if any, and releases it
+ */
+void stopLexer( Compilation * c );
+
+#endif
@@ -8,15 +8,90 @@
 #ifndef _SCAN_H_
 #define _SCAN_H_
 
-/* MAXTOKENLEN is the maximum size of a token */
-#define MAXTOKENLEN 40
+/* the reasons a scanner cannot be made */
+#define NOMEMORY 1  /* memory is exhausted */
+#define READERROR 2 /* the file cannot be read */
+#define TOOLARGE 3  /* the file is too large to scan */
 
-/* tokenString array stores the lexeme of each token */
-extern char tokenString[MAXTOKENLEN+1];
+/* Function newScanner returns a scanner that
+ * reads file, or the text given to feedText if
+ * file is NULL. It returns NULL if it cannot
+ * make one, with the reason in *failure
+ */
+void * newScanner(FILE * file, int * failure);
+
+/* Procedure freeScanner releases a scanner
+ * returned by newScanner
+ */
+void freeScanner(void * scanner);
+
+/* Function scannerText returns the source text
+ * of a scanner made from a file, which is
+ * entirely in memory
+ */
+const char * scannerText(void * scanner);
+
+/* Function feedText appends the length bytes
+ * at text to the source of a scanner made with
+ * no file, outside of a slice. It returns FALSE
+ * if memory is exhausted or the source is too
+ * large
+ */
+int feedText(void * scanner, const char * text, size_t length);
+
+/* Function beginSlice begins a slice of the text
+ * fed to scanner: getToken scans what was not
+ * scanned yet up to the end of its last complete
+ * line, or up to its end if last is TRUE, and
+ * then returns ENDFILE. It returns FALSE, and
+ * begins no slice, if there is no complete line
+ */
+int beginSlice(void * scanner, int last);
+
+/* Function endSlice ends the slice of scanner
+ * begun by beginSlice and drops the text it
+ * scanned, so that a fed source is never held
+ * whole, nor a comment: of one still open at the
+ * end of the slice only the last byte is kept,
+ * from which the next slice searches for its
+ * end. It
+ * returns FALSE if memory is exhausted
+ */
+int endSlice(void * scanner);
+
+/* Function lineOf returns the line of the source
+ * of the current compilation on which offset
+ * lies. Lines are not counted while scanning:
+ * the first call indexes the newlines of the
+ * source
+ */
+int lineOf(unsigned offset);
+
+/* Procedure forgetLines tells the scanner of
+ * the current compilation that lineOf will not
+ * be asked for an offset before offset again,
+ * so that the newline index can forget what is
+ * before it
+ */
+void forgetLines(unsigned offset);
 
 /* function getToken returns the 
- * next token in source file
+ * next token in the source file of compilation
+ * c and stores its semantic value in *value:
+ * the interned name of an ID, the value of a
+ * NUM. The lexeme is left in c->tokenString,
+ * a slice of the scanner buffer, not a copy,
+ * that is valid until the next call
+ */
+TokenType getToken(Compilation * c, YYSTYPE * value);
+
+/* Function scanToken returns the next token of
+ * scanner with the offset and length of its
+ * lexeme in the source text, but no semantic
+ * value. It uses no state of the compilation,
+ * so that a thread of its own can scan the
+ * source while the compilation parses it
  */
-TokenType getToken(void);
+TokenType scanToken(void * scanner, unsigned * offset, size_t * length);
 
 #endif
@@ -1,147 +1,415 @@
 /****************************************************/
 /* File: symtab.c                                   */
 /* Symbol table implementation for the TINY compiler*/
-/* (allows only one symbol table)                   */
-/* Symbol table is implemented as a chained         */
-/* hash table                                       */
+/* Symbol table is a stack of scopes, each one      */
+/* implemented as an open addressing hash table     */
+/* with linear probing                              */
 /* Compiler Construction: Principles and Practice   */
 /* Kenneth C. Louden                                */
 /****************************************************/
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+#include "globals.h"
 #include "symtab.h"
+#include "intern.h"
+#include "scan.h"
 
 
-/* SIZE is the size of the hash table */
-#define SIZE 211
-
-
-
-/* SHIFT is the power of two used as multiplier
-   in hash function  */
-#define SHIFT 4
+/* INITSIZE is the initial number of slots in
+ * the hash table of a scope (a power of two);
+ * a table doubles whenever it becomes half full
+ */
+#define INITSIZE 8
 
-/* the hash function */
-static int hash ( char * key )
-{ int temp = 0;
-  int i = 0;
-  while (key[i] != '\0')
-  { temp = ((temp << SHIFT) + key[i]) % SIZE;
-    ++i;
-  }
-  return temp;
-}
+/* the list of places in the source code in
+ * which a variable is referenced, kept as a
+ * growable array of differences between
+ * consecutive source offsets (see lineOf), or
+ * line numbers when streaming, since lineOf
+ * forgets the lines of the text behind it; each
+ * difference is zigzag encoded and stored in
+ * groups of 7 bits, so that most take 1 byte
+ */
+typedef struct
+   { unsigned char * bytes;
+     unsigned used; /* bytes in use */
+     unsigned size; /* bytes allocated */
+     unsigned last; /* the offset added last */
+   } LineList;
 
-/* the list of line numbers of the source
- * code in which a variable is referenced
+/* MAXLINEBYTES is the largest number of bytes
+ * taken by one encoded difference
  */
-typedef struct LineListRec
-   { int lineno;
-     struct LineListRec * next;
-   } * LineList;
+#define MAXLINEBYTES 5
 
-/* The record in the bucket lists for
- * each variable, including name,
- * assigned memory location, and
+/* The record of each variable, including
+ * name, assigned memory location, and
  * the list of line numbers in which
  * it appears in the source code
  */
-typedef struct BucketListRec
+struct SymbolRec
    { char * name;
      LineList lines;
      int memloc ; /* memory location for variable */
-     struct BucketListRec * next;
-     char * scope;
+     struct SymbolRec * next; /* symbols of the scope in order of declaration */
      char * typeID;
      char * typedata;
-   } * BucketList;
+   };
+
+/* A slot of the open addressing hash table
+ * of a scope; name is NULL for an empty slot.
+ * The hash is kept in the slot so that the
+ * table can grow without rehashing names
+ */
+typedef struct
+   { unsigned hash;
+     char * name;
+     Symbol sym;
+   } Slot;
+
+/* The record of each scope: its own hash
+ * table and a link to the enclosing scope,
+ * which is searched when a name is not
+ * declared locally
+ */
+typedef struct ScopeRec
+   { char * name; /* function name, NULL for the global scope */
+     struct ScopeRec * parent;
+     struct ScopeRec * next; /* scopes in order of creation */
+     Slot * slots;
+     unsigned size;  /* number of slots (a power of two) */
+     unsigned count; /* number of symbols */
+     Symbol first, last; /* symbols in order of declaration */
+   } * Scope;
+
+/* The scopes of a compilation are reached from its
+ * globalScope, currentScope (the innermost open
+ * scope) and lastScope (the last scope created)
+ */
+
+/* Function newScope allocates an empty scope
+ * nested in parent
+ */
+static Scope newScope( char * name, Scope parent )
+{ Scope s = (Scope) calloc(1,sizeof(struct ScopeRec));
+  s->name = name;
+  s->parent = parent;
+  s->size = INITSIZE;
+  s->slots = (Slot *) calloc(INITSIZE,sizeof(Slot));
+  if (compilation->lastScope != NULL) compilation->lastScope->next = s;
+  compilation->lastScope = s;
+  return s;
+}
+
+/* Function top returns the innermost open scope,
+ * creating the global scope on first use
+ */
+static Scope top(void)
+{ if (compilation->globalScope == NULL)
+    compilation->globalScope = compilation->currentScope = newScope(NULL,NULL);
+  return compilation->currentScope;
+}
+
+/* Function probe returns the slot of name in
+ * scope s: the slot holding it, or the empty
+ * slot where it would be inserted
+ */
+static Slot * probe( Scope s, char * name, unsigned h )
+{ unsigned mask = s->size - 1;
+  unsigned i = h & mask;
+  while ((s->slots[i].name != NULL) && (s->slots[i].name != name))
+    i = (i+1) & mask;
+  return &s->slots[i];
+}
 
-/* the hash table */
-static BucketList hashTable[SIZE];
+/* Procedure grow doubles the hash table of
+ * scope s, moving every slot to its new place
+ */
+static void grow( Scope s )
+{ Slot * old = s->slots;
+  unsigned oldSize = s->size;
+  unsigned i;
+  s->size *= 2;
+  s->slots = (Slot *) calloc(s->size,sizeof(Slot));
+  for (i=0;i<oldSize;i++)
+    if (old[i].name != NULL)
+      *probe(s,old[i].name,old[i].hash) = old[i];
+  free(old);
+}
+
+/* Function find returns the record of name
+ * declared in scope s or an enclosing scope,
+ * or NULL if the name is not visible from s
+ */
+static Symbol find( char * name, unsigned h, Scope s )
+{ for (; s != NULL; s = s->parent)
+  { Slot * slot = probe(s,name,h);
+    if (slot->name != NULL) return slot->sym;
+  }
+  return NULL;
+}
+
+/* Procedure addLine appends the source offset
+ * pos to the list lines, or leaves it out if
+ * memory is exhausted
+ */
+static void addLine( LineList * lines, unsigned pos )
+{ long long diff;
+  unsigned long long delta;
+  if (Streaming) pos = (unsigned) lineOf(pos);
+  diff = (long long) pos - lines->last;
+  delta = diff < 0 ? 2*(unsigned long long) -(diff+1) + 1 : 2*(unsigned long long) diff;
+  if (lines->used + MAXLINEBYTES > lines->size)
+  { unsigned size = lines->size ? 2*lines->size : 4*MAXLINEBYTES;
+    unsigned char * bytes = (unsigned char *) realloc(lines->bytes,size);
+    if (bytes == NULL)
+    { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+      return;
+    }
+    lines->bytes = bytes;
+    lines->size = size;
+  }
+  while (delta >= 0x80)
+  { lines->bytes[lines->used++] = (unsigned char) (delta | 0x80);
+    delta >>= 7;
+  }
+  lines->bytes[lines->used++] = (unsigned char) delta;
+  lines->last = pos;
+}
+
+/* Procedure st_enter_scope opens a new scope
+ * nested in the current one
+ */
+void st_enter_scope( char * name )
+{ compilation->currentScope = newScope(name,top());
+}
+
+/* Procedure st_exit_scope closes the current
+ * scope and returns to the enclosing one
+ */
+void st_exit_scope(void)
+{ if (top()->parent != NULL)
+    compilation->currentScope = compilation->currentScope->parent;
+}
+
+/* Function checkFunctionType returns 1 if the
+ * record l is declared with type int, 0 if it is
+ * declared otherwise and 2 if l is NULL
+ */
+int checkFunctionType (Symbol l)
+{
+  if (l == NULL) return 2;
+  else if (strcmp(l->typedata,"int")==0) return 1;
+  else return 0;
+
+}
+
+/* Function st_find_or_insert returns the record
+ * of name if it is visible from the current scope;
+ * otherwise it declares name in the current scope
+ * with memory location loc and returns the new
+ * record. *created tells which case happened
+ */
+Symbol st_find_or_insert( char * name, unsigned pos, int loc, char * typeID, char * typedata, int * created )
+{ unsigned h = internHash(name);
+  Scope currentScope = top();
+  Symbol l = find(name,h,currentScope);
+  Slot * slot;
+  *created = (l == NULL);
+  if (l != NULL) return l;
+  if (2*(currentScope->count+1) > currentScope->size)
+    grow(currentScope);
+  slot = probe(currentScope,name,h);
+  l = (Symbol) malloc(sizeof(struct SymbolRec));
+  l->name = name;
+  l->typeID = typeID;
+  l->typedata = typedata;
+  l->lines.bytes = NULL;
+  l->lines.used = l->lines.size = 0;
+  l->lines.last = 0;
+  addLine(&l->lines,pos);
+  l->memloc = loc;
+  l->next = NULL;
+  if (currentScope->last != NULL) currentScope->last->next = l;
+  else currentScope->first = l;
+  currentScope->last = l;
+  currentScope->count++;
+  slot->hash = h;
+  slot->name = name;
+  slot->sym = l;
+  return l;
+} /* st_find_or_insert */
+
+/* Function st_find returns the record of name
+ * if it is visible from the current scope,
+ * or NULL if it is not
+ */
+Symbol st_find( char * name )
+{ return find(name,internHash(name),top());
+}
+
+/* Procedure st_add_line adds the line of source
+ * offset pos to the line numbers in which the
+ * variable of record l is referenced
+ */
+void st_add_line( Symbol l, unsigned pos )
+{ addLine(&l->lines,pos);
+}
 
 /* Procedure st_insert inserts line numbers and
  * memory locations into the symbol table
  * loc = memory location is inserted only the
  * first time, otherwise ignored
  */
-int checkFunctionType (char * name)
-{
-  int h = hash(name);
-  int kasa;
-    BucketList l =  hashTable[h];
-    while   (  (l != NULL) && !(  (strcmp(name,l->name)==0) ) )
-    l = l->next;
-    if (l == NULL) return 2;
-    else if (strcmp(l->typedata,"int")==0) return 1;
-    else return 0;
-
-}
-
-void st_insert( char * name, int lineno, int loc, char * scope, char * typeID, char * typedata )
-{ int h = hash(name);
-  BucketList l =  hashTable[h];
-  while (  (l != NULL) && !(  (strcmp(name,l->name)==0) && ((strcmp(scope,l->scope)==0) || (strcmp(l->scope," ")==0))    ) )
-    l = l->next;
-  if (l == NULL) /* variable not yet in table */
-  { l = (BucketList) malloc(sizeof(struct BucketListRec));
-    l->name = name;
-    l->scope = scope;
-    l->typeID = typeID;
-    l->typedata = typedata;
-    l->lines = (LineList) malloc(sizeof(struct LineListRec));
-    l->lines->lineno = lineno;
-    l->memloc = loc;
-    l->lines->next = NULL;
-    l->next = hashTable[h];
-    hashTable[h] = l; }
-  else /* found in table, so just add line number */
-  { LineList t = l->lines;
-    while (t->next != NULL) t = t->next;
-    t->next = (LineList) malloc(sizeof(struct LineListRec));
-    t->next->lineno = lineno;
-    t->next->next = NULL;
-  }
+void st_insert( char * name, unsigned pos, int loc, char * typeID, char * typedata )
+{ int created;
+  Symbol l = st_find_or_insert(name,pos,loc,typeID,typedata,&created);
+  if (!created) /* found in table, so just add line number */
+    addLine(&l->lines,pos);
 } /* st_insert */
 
 /* Function st_lookup returns the memory
  * location of a variable or -1 if not found
  */
-int st_lookup ( char * name, char * scope )
-{ int h = hash(name);
-  BucketList l =  hashTable[h];
-  while   (  (l != NULL) && !(  (strcmp(name,l->name)==0) && ((strcmp(scope,l->scope)==0) || (strcmp(l->scope," ")==0))    ) )
-    l = l->next;
+int st_lookup ( char * name )
+{ Symbol l = st_find(name);
   if (l == NULL) return -1;
   else return l->memloc;
 }
 
+/* Procedure printHeader prints the heading of
+ * a listing of the symbol table
+ */
+static void printHeader(FILE * listing)
+{ fprintf(listing,"Variable Name  Location   Scope   TypeID   Type Data   Line Numbers\n");
+  fprintf(listing,"-------------  --------   -----   ------   ---------   ------------\n");
+}
+
+/* Procedure printScopes prints the symbols of
+ * scope s and of every scope created after it
+ */
+static void printScopes(FILE * listing, Scope s)
+{ for (; s != NULL; s = s->next)
+  { Symbol l = s->first;
+    while (l != NULL)
+    { unsigned i = 0;
+      unsigned pos = 0;
+      fprintf(listing,"%-14s ",l->name);
+      fprintf(listing,"%-9d  ",l->memloc);
+      fprintf(listing,"%-7s ",s->name != NULL ? s->name : " ");
+      fprintf(listing,"%-8s ",l->typeID);
+      fprintf(listing,"%-10s ",l->typedata);
+      while (i < l->lines.used)
+      { unsigned long long delta = 0;
+        int shift = 0;
+        do
+        { delta |= (unsigned long long) (l->lines.bytes[i] & 0x7f) << shift;
+          shift += 7;
+        } while (l->lines.bytes[i++] & 0x80);
+        pos += (delta & 1) ? -(unsigned) (delta >> 1) - 1 : (unsigned) (delta >> 1);
+        fprintf(listing,"%4d ",Streaming ? (int) pos : lineOf(pos));
+      }
+      fprintf(listing,"\n");
+      l = l->next;
+    }
+  }
+}
+
 /* Procedure printSymTab prints a formatted
  * listing of the symbol table contents
  * to the listing file
  */
 void printSymTab(FILE * listing)
-{ int i;
-  fprintf(listing,"Variable Name  Location   Scope   TypeID   Type Data   Line Numbers\n");
-  fprintf(listing,"-------------  --------   -----   ------   ---------   ------------\n");
-  for (i=0;i<SIZE;++i)
-  { if (hashTable[i] != NULL)
-    { BucketList l = hashTable[i];
-      while (l != NULL)
-      { LineList t = l->lines;
-        fprintf(listing,"%-14s ",l->name);
-        fprintf(listing,"%-9d  ",l->memloc);
-        fprintf(listing,"%-7s ",l->scope);
-        fprintf(listing,"%-8s ",l->typeID);
-        fprintf(listing,"%-10s ",l->typedata);
-        while (t != NULL)
-        { fprintf(listing,"%4d ",t->lineno);
-          t = t->next;
-        }
-        fprintf(listing,"\n");
-        l = l->next;
-      }
+{ printHeader(listing);
+  printScopes(listing,compilation->globalScope);
+} /* printSymTab */
+
+/* Procedure freeScopes discards scope s, every
+ * scope created after it and their symbols
+ */
+static void freeScopes( Scope s )
+{ while (s != NULL)
+  { Scope next = s->next;
+    Symbol l = s->first;
+    while (l != NULL)
+    { Symbol n = l->next;
+      free(l->lines.bytes);
+      free(l);
+      l = n;
     }
+    free(s->slots);
+    free(s);
+    s = next;
   }
-} /* printSymTab */
+}
+
+/* Procedure st_flush_scopes prints the symbols
+ * of every scope but the global one to listing,
+ * unless it is NULL, and discards them. It does
+ * nothing while a scope other than the global
+ * one is open
+ */
+void st_flush_scopes(FILE * listing)
+{ Scope g = compilation->globalScope;
+  if ((g == NULL) || (g->next == NULL) || (compilation->currentScope != g))
+    return;
+  if (listing != NULL)
+  { printHeader(listing);
+    printScopes(listing,g->next);
+  }
+  freeScopes(g->next);
+  g->next = NULL;
+  compilation->lastScope = g;
+}
+
+/* Procedure st_release discards every scope and
+ * symbol of the current compilation
+ */
+void st_release(void)
+{ freeScopes(compilation->globalScope);
+  compilation->globalScope = NULL;
+  compilation->currentScope = NULL;
+  compilation->lastScope = NULL;
+}
+
+/* MAXPROBE is the last bucket of the probe
+ * length histogram: it counts every symbol
+ * found after MAXPROBE or more probes
+ */
+#define MAXPROBE 8
+
+/* Procedure printSymTabStats prints the load
+ * factor of the scope tables and a histogram of
+ * the number of probes needed to find each
+ * symbol to the listing file
+ */
+void printSymTabStats(FILE * listing)
+{ unsigned long histogram[MAXPROBE+1];
+  unsigned long scopes = 0, symbols = 0, slots = 0, probes = 0;
+  double maxLoad = 0.0;
+  Scope s;
+  unsigned i;
+  for (i=0;i<=MAXPROBE;i++) histogram[i] = 0;
+  for (s = compilation->globalScope; s != NULL; s = s->next)
+  { unsigned mask = s->size - 1;
+    scopes++;
+    symbols += s->count;
+    slots += s->size;
+    if ((double) s->count / s->size > maxLoad)
+      maxLoad = (double) s->count / s->size;
+    for (i=0;i<s->size;i++)
+      if (s->slots[i].name != NULL)
+      { unsigned n = ((i - s->slots[i].hash) & mask) + 1;
+        probes += n;
+        histogram[n < MAXPROBE ? n : MAXPROBE]++;
+      }
+  }
+  fprintf(listing,"\nSymbol table statistics:\n\n");
+  fprintf(listing,"scopes: %lu  symbols: %lu  slots: %lu\n",scopes,symbols,slots);
+  fprintf(listing,"load factor: %.3f overall, %.3f in the fullest scope\n",
+          slots ? (double) symbols / slots : 0.0, maxLoad);
+  fprintf(listing,"average probes per hit: %.3f\n",
+          symbols ? (double) probes / symbols : 0.0);
+  fprintf(listing,"probes   symbols\n");
+  for (i=1;i<=MAXPROBE;i++)
+    fprintf(listing,"%6u%s  %lu\n",i,i < MAXPROBE ? " " : "+",histogram[i]);
+} /* printSymTabStats */
@@ -1,7 +1,7 @@
 /****************************************************/
 /* File: symtab.h                                   */
 /* Symbol table interface for the TINY compiler     */
-/* (allows only one symbol table)                   */
+/* (a stack of nested scopes)                       */
 /* Compiler Construction: Principles and Practice   */
 /* Kenneth C. Louden                                */
 /****************************************************/
@@ -9,19 +9,67 @@
 #ifndef _SYMTAB_H_
 #define _SYMTAB_H_
 
+/* Names are compared by pointer, so every
+ * name given to the table must come from
+ * internString
+ */
+
+/* Symbol is the record kept in the table
+ * for each declared name
+ */
+typedef struct SymbolRec * Symbol;
+
+/* Procedure st_enter_scope opens a new scope
+ * nested in the current one; the global scope
+ * is open from the start
+ */
+void st_enter_scope( char * name );
+
+/* Procedure st_exit_scope closes the current
+ * scope and returns to the enclosing one
+ */
+void st_exit_scope(void);
+
+/* Function st_find_or_insert returns the record
+ * of name if it is visible from the current scope;
+ * otherwise it declares name in the current scope
+ * with memory location loc and returns the new
+ * record. *created tells which case happened
+ */
+Symbol st_find_or_insert( char * name, unsigned pos, int loc, char * typeID, char * typedata, int * created );
+
+/* Function st_find returns the record of name
+ * if it is visible from the current scope,
+ * or NULL if it is not
+ */
+Symbol st_find( char * name );
+
+/* Procedure st_add_line adds the line of source
+ * offset pos to the line numbers in which the
+ * variable of record l is referenced
+ */
+void st_add_line( Symbol l, unsigned pos );
+
 /* Procedure st_insert inserts line numbers and
  * memory locations into the symbol table
  * loc = memory location is inserted only the
  * first time, otherwise ignored
+ * A name not visible from the current scope
+ * is declared in the current scope
  */
-void st_insert( char * name, int lineno, int loc, char * scope, char * typeID, char * typedata );
+void st_insert( char * name, unsigned pos, int loc, char * typeID, char * typedata );
 
 /* Function st_lookup returns the memory
- * location of a variable or -1 if not found
+ * location of a variable visible from the
+ * current scope or -1 if not found
  */
-int st_lookup ( char * name , char * scope );
+int st_lookup ( char * name );
 
-int checkFunctionType (char * name);
+/* Function checkFunctionType returns 1 if the
+ * record l is declared with type int, 0 if it is
+ * declared otherwise and 2 if l is NULL
+ */
+int checkFunctionType (Symbol l);
 
 /* Procedure printSymTab prints a formatted
  * listing of the symbol table contents
@@ -29,4 +77,24 @@ int checkFunctionType (char * name);
  */
 void printSymTab(FILE * listing);
 
+/* Procedure printSymTabStats prints the load
+ * factor of the scope tables and a histogram of
+ * the number of probes needed to find each
+ * symbol to the listing file
+ */
+void printSymTabStats(FILE * listing);
+
+/* Procedure st_flush_scopes prints the symbols
+ * of every closed scope but the global one to
+ * listing, unless it is NULL, and discards them,
+ * so that a source analyzed a declaration at a
+ * time keeps only its global symbols
+ */
+void st_flush_scopes(FILE * listing);
+
+/* Procedure st_release discards every scope and
+ * symbol of the current compilation
+ */
+void st_release(void);
+
 #endif
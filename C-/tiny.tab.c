@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,20 +45,20 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
-#define YYPUSH 0
+#define YYPUSH 1
 
 /* Pull parsers.  */
 #define YYPULL 1
@@ -61,136 +66,212 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 7 "tiny.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 7 "tiny.y"
 
 #define YYPARSER /* distinguishes Yacc output from other code files */
 
 #include "globals.h"
 #include "util.h"
-#include "scan.h"
-#include "parse.h"
+#include "intern.h"
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
-#define YYSTYPE TreeNode *
-int yyerror(char * message);
-static char * savedName; /* for use in assignments */
-static int savedLineNo;  /* ditto */
-static TreeNode * savedTree; /* stores syntax tree for later return */
-static int yylex(void);
 
+#line 83 "tiny.tab.c"
 
-#line 85 "tiny.tab.c" /* yacc.c:339  */
-
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "tiny.tab.h".  */
-#ifndef YY_YY_TINY_TAB_H_INCLUDED
-# define YY_YY_TINY_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    ID = 258,
-    NUM = 259,
-    SEMI = 260,
-    COMMA = 261,
-    IF = 262,
-    INT = 263,
-    ELSE = 264,
-    RETURN = 265,
-    VOID = 266,
-    WHILE = 267,
-    ASSIGN = 268,
-    EQUAL = 269,
-    LT = 270,
-    LTEQ = 271,
-    GT = 272,
-    GTEQ = 273,
-    DIFF = 274,
-    LPAREN = 275,
-    RPAREN = 276,
-    LBRACKETS = 277,
-    RBRACKETS = 278,
-    LKEY = 279,
-    RKEY = 280,
-    PLUS = 281,
-    MINUS = 282,
-    TIMES = 283,
-    OVER = 284,
-    ERROR = 285
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef int YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+#include "tiny.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_ID = 3,                         /* ID  */
+  YYSYMBOL_NUM = 4,                        /* NUM  */
+  YYSYMBOL_SEMI = 5,                       /* SEMI  */
+  YYSYMBOL_COMMA = 6,                      /* COMMA  */
+  YYSYMBOL_IF = 7,                         /* IF  */
+  YYSYMBOL_INT = 8,                        /* INT  */
+  YYSYMBOL_ELSE = 9,                       /* ELSE  */
+  YYSYMBOL_RETURN = 10,                    /* RETURN  */
+  YYSYMBOL_VOID = 11,                      /* VOID  */
+  YYSYMBOL_WHILE = 12,                     /* WHILE  */
+  YYSYMBOL_ASSIGN = 13,                    /* ASSIGN  */
+  YYSYMBOL_EQUAL = 14,                     /* EQUAL  */
+  YYSYMBOL_LT = 15,                        /* LT  */
+  YYSYMBOL_LTEQ = 16,                      /* LTEQ  */
+  YYSYMBOL_GT = 17,                        /* GT  */
+  YYSYMBOL_GTEQ = 18,                      /* GTEQ  */
+  YYSYMBOL_DIFF = 19,                      /* DIFF  */
+  YYSYMBOL_LPAREN = 20,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 21,                    /* RPAREN  */
+  YYSYMBOL_LBRACKETS = 22,                 /* LBRACKETS  */
+  YYSYMBOL_RBRACKETS = 23,                 /* RBRACKETS  */
+  YYSYMBOL_LKEY = 24,                      /* LKEY  */
+  YYSYMBOL_RKEY = 25,                      /* RKEY  */
+  YYSYMBOL_PLUS = 26,                      /* PLUS  */
+  YYSYMBOL_MINUS = 27,                     /* MINUS  */
+  YYSYMBOL_TIMES = 28,                     /* TIMES  */
+  YYSYMBOL_OVER = 29,                      /* OVER  */
+  YYSYMBOL_ERROR = 30,                     /* ERROR  */
+  YYSYMBOL_YYACCEPT = 31,                  /* $accept  */
+  YYSYMBOL_PROGRAM = 32,                   /* PROGRAM  */
+  YYSYMBOL_stmt_seq = 33,                  /* stmt_seq  */
+  YYSYMBOL_stmt = 34,                      /* stmt  */
+  YYSYMBOL_var_stmt = 35,                  /* var_stmt  */
+  YYSYMBOL_type_id = 36,                   /* type_id  */
+  YYSYMBOL_func_stmt = 37,                 /* func_stmt  */
+  YYSYMBOL_params = 38,                    /* params  */
+  YYSYMBOL_param_list = 39,                /* param_list  */
+  YYSYMBOL_param = 40,                     /* param  */
+  YYSYMBOL_comp_stmt = 41,                 /* comp_stmt  */
+  YYSYMBOL_local_stmt = 42,                /* local_stmt  */
+  YYSYMBOL_stmtem_seq = 43,                /* stmtem_seq  */
+  YYSYMBOL_stmtem = 44,                    /* stmtem  */
+  YYSYMBOL_exp_stmt = 45,                  /* exp_stmt  */
+  YYSYMBOL_if_stmt = 46,                   /* if_stmt  */
+  YYSYMBOL_while_stmt = 47,                /* while_stmt  */
+  YYSYMBOL_return_stmt = 48,               /* return_stmt  */
+  YYSYMBOL_exp = 49,                       /* exp  */
+  YYSYMBOL_var = 50,                       /* var  */
+  YYSYMBOL_simples_exp = 51,               /* simples_exp  */
+  YYSYMBOL_relacional = 52,                /* relacional  */
+  YYSYMBOL_soma_exp = 53,                  /* soma_exp  */
+  YYSYMBOL_term = 54,                      /* term  */
+  YYSYMBOL_factor = 55,                    /* factor  */
+  YYSYMBOL_call = 56,                      /* call  */
+  YYSYMBOL_args = 57,                      /* args  */
+  YYSYMBOL_arg_list = 58,                  /* arg_list  */
+  YYSYMBOL_id = 59,                        /* id  */
+  YYSYMBOL_num = 60,                       /* num  */
+  YYSYMBOL_empty = 61                      /* empty  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-extern YYSTYPE yylval;
+/* Second part of user prologue.  */
+#line 25 "tiny.y"
 
-int yyparse (void);
+#include "parse.h"
+#include "scan.h"
+#include "tokens.h"
+#include "pipeline.h"
 
-#endif /* !YY_YY_TINY_TAB_H_INCLUDED  */
+static int yylex(YYSTYPE * lvalp, Compilation * unit);
+static Node declare(Compilation * unit, Node t);
 
-/* Copy the second part of user declarations.  */
+#line 188 "tiny.tab.c"
 
-#line 167 "tiny.tab.c" /* yacc.c:358  */
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short int yytype_int16;
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -198,15 +279,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -220,47 +314,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -273,34 +363,24 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
 
-/* The parser invokes alloca or malloc; define the necessary symbols.  */
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-# ifdef YYSTACK_USE_ALLOCA
-#  if YYSTACK_USE_ALLOCA
-#   ifdef __GNUC__
-#    define YYSTACK_ALLOC __builtin_alloca
-#   elif defined __BUILTIN_VA_ARG_INCR
-#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
-#   elif defined _AIX
-#    define YYSTACK_ALLOC __alloca
-#   elif defined _MSC_VER
-#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
-#    define alloca _alloca
-#   else
-#    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
-#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
-#     ifndef EXIT_SUCCESS
-#      define EXIT_SUCCESS 0
-#     endif
-#    endif
-#   endif
-#  endif
-# endif
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
 
 # ifdef YYSTACK_ALLOC
    /* Pacify GCC's 'empty if-body' warning.  */
@@ -339,8 +419,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -349,17 +428,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -372,11 +451,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -388,12 +467,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -416,17 +495,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  107
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   285
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -460,60 +542,62 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,    37,    37,    43,    44,    57,    58,    61,    66,    74,
-      81,    89,   101,   107,   111,   122,   126,   132,   139,   152,
-     163,   167,   178,   181,   182,   183,   184,   185,   188,   190,
-     194,   200,   209,   217,   219,   226,   231,   235,   237,   245,
-     252,   255,   259,   263,   267,   271,   275,   281,   288,   295,
-     298,   305,   312,   315,   317,   319,   321,   326,   334,   336,
-     339,   350,   356,   363,   370
+       0,    54,    54,    60,    61,    65,    66,    69,    74,    82,
+      89,    97,   106,   112,   116,   118,   122,   128,   135,   139,
+     141,   145,   147,   150,   151,   152,   153,   154,   157,   159,
+     163,   169,   178,   186,   188,   195,   200,   204,   206,   214,
+     221,   224,   228,   232,   236,   240,   244,   250,   257,   264,
+     267,   274,   281,   284,   286,   288,   290,   295,   303,   305,
+     308,   310,   316,   323,   330
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "ID", "NUM", "SEMI", "COMMA", "IF",
-  "INT", "ELSE", "RETURN", "VOID", "WHILE", "ASSIGN", "EQUAL", "LT",
-  "LTEQ", "GT", "GTEQ", "DIFF", "LPAREN", "RPAREN", "LBRACKETS",
-  "RBRACKETS", "LKEY", "RKEY", "PLUS", "MINUS", "TIMES", "OVER", "ERROR",
-  "$accept", "PROGRAM", "stmt_seq", "stmt", "var_stmt", "type_id",
-  "func_stmt", "params", "param_list", "param", "comp_stmt", "local_stmt",
-  "stmtem_seq", "stmtem", "exp_stmt", "if_stmt", "while_stmt",
-  "return_stmt", "exp", "var", "simples_exp", "relacional", "soma_exp",
-  "term", "factor", "call", "args", "arg_list", "id", "num", "empty", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "ID", "NUM", "SEMI",
+  "COMMA", "IF", "INT", "ELSE", "RETURN", "VOID", "WHILE", "ASSIGN",
+  "EQUAL", "LT", "LTEQ", "GT", "GTEQ", "DIFF", "LPAREN", "RPAREN",
+  "LBRACKETS", "RBRACKETS", "LKEY", "RKEY", "PLUS", "MINUS", "TIMES",
+  "OVER", "ERROR", "$accept", "PROGRAM", "stmt_seq", "stmt", "var_stmt",
+  "type_id", "func_stmt", "params", "param_list", "param", "comp_stmt",
+  "local_stmt", "stmtem_seq", "stmtem", "exp_stmt", "if_stmt",
+  "while_stmt", "return_stmt", "exp", "var", "simples_exp", "relacional",
+  "soma_exp", "term", "factor", "call", "args", "arg_list", "id", "num",
+  "empty", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -45
+#define YYPACT_NINF (-45)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-45)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -14
+#define YYTABLE_NINF (-14)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
        9,   -45,   -45,    12,     9,   -45,   -45,     7,   -45,   -45,
@@ -529,10 +613,10 @@ static const yytype_int8 yypact[] =
       48,   -45,    87,   -45,   -45,    36,   -45
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,     9,    10,     0,     2,     3,     5,     0,     6,     1,
        4,    62,     0,     7,     0,     0,    10,     0,     0,    12,
@@ -547,7 +631,7 @@ static const yytype_uint8 yydefact[] =
        0,    38,    30,    32,    60,     0,    31
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -45,   -45,   -45,    94,    68,   -10,   -45,   -45,   -45,    75,
@@ -556,18 +640,18 @@ static const yytype_int8 yypgoto[] =
      -32
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     3,     4,     5,     6,     7,     8,    18,    19,    20,
+       0,     3,     4,     5,     6,     7,     8,    18,    19,    20,
       46,    33,    37,    47,    48,    49,    50,    51,    52,    53,
       54,    76,    55,    56,    57,    58,    93,    94,    59,    60,
       34
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
       63,    38,    65,    12,    17,    77,    78,    11,    21,    40,
@@ -583,7 +667,7 @@ static const yytype_int8 yytable[] =
       30,    35,    29,    22
 };
 
-static const yytype_uint8 yycheck[] =
+static const yytype_int8 yycheck[] =
 {
       42,    33,    44,     7,    14,    28,    29,     3,     4,     5,
        3,     7,     0,    17,    10,    25,    12,     8,     8,    61,
@@ -598,9 +682,9 @@ static const yytype_uint8 yycheck[] =
       25,    33,    24,    15
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     8,    11,    32,    33,    34,    35,    36,    37,     0,
       34,     3,    59,     5,    20,    22,    11,    36,    38,    39,
@@ -615,8 +699,8 @@ static const yytype_uint8 yystos[] =
        6,    23,    44,    44,    49,     9,    44
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    31,    32,    33,    33,    34,    34,    35,    35,    36,
       36,    37,    38,    38,    39,    39,    40,    40,    41,    42,
@@ -627,8 +711,8 @@ static const yytype_uint8 yyr1[] =
       58,    58,    59,    60,    61
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     1,     2,     1,     1,     3,     6,     1,
        1,     6,     1,     1,     3,     1,     2,     4,     4,     2,
@@ -640,39 +724,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (unit, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -689,55 +773,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, unit); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, Compilation * unit)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (unit);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, Compilation * unit)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, unit);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -746,7 +828,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -769,21 +851,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, Compilation * unit)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], unit);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -791,15 +873,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, unit); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -820,303 +902,179 @@ int yydebug;
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH 10000
 #endif
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
 
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
 
-#if YYERROR_VERBOSE
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
 
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, Compilation * unit)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (unit);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
+int
+yyparse (Compilation * unit)
+{
+  yypstate *yyps = yypstate_new ();
+  if (!yyps)
+    {
+      yyerror (unit, YY_("memory exhausted"));
+      return 2;
+    }
+  int yystatus = yypull_parse (yyps, unit);
+  yypstate_delete (yyps);
+  return yystatus;
+}
 
+int
+yypull_parse (yypstate *yyps, Compilation * unit)
+{
+  YY_ASSERT (yyps);
+  int yystatus;
+  do {
+    YYSTYPE yylval;
+    int yychar = yylex (&yylval, unit);
+    yystatus = yypush_parse (yyps, yychar, &yylval, unit);
+  } while (yystatus == YYPUSH_MORE);
+  return yystatus;
+}
 
-/*----------.
-| yyparse.  |
-`----------*/
+#define yynerrs yyps->yynerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yystacksize yyps->yystacksize
+
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
 
-int
-yyparse (void)
+  yyssp = yyss;
+  yyvsp = yyvs;
+
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
+
+/* Initialize the parser data structure.  */
+yypstate *
+yypstate_new (void)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yypstate_clear (yyps);
+  return yyps;
+}
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+void
+yypstate_delete (yypstate *yyps)
+{
+  if (yyps)
+    {
+#ifndef yyoverflow
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
+#endif
+      YYFREE (yyps);
+    }
+}
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+/*---------------.
+| yypush_parse.  |
+`---------------*/
 
-    YYSIZE_T yystacksize;
+int
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, Compilation * unit)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1124,71 +1082,89 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
+
+    case 2:
+      yypstate_clear (yyps);
+      break;
+
+    default:
+      break;
+    }
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1196,30 +1172,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1230,18 +1207,39 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
+        }
+      yyps->yynew = 0;
+yyread_pushed_token:
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1269,15 +1267,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1292,7 +1288,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1312,543 +1308,487 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 38 "tiny.y" /* yacc.c:1646  */
-    {savedTree = (yyvsp[0]);}
-#line 1319 "tiny.tab.c" /* yacc.c:1646  */
+  case 2: /* PROGRAM: stmt_seq  */
+#line 55 "tiny.y"
+                                                        {unit->syntaxTree = (yyvsp[0].list).head;}
+#line 1315 "tiny.tab.c"
     break;
 
-  case 3:
-#line 43 "tiny.y" /* yacc.c:1646  */
-    { (yyval) =  (yyvsp[0]); }
-#line 1325 "tiny.tab.c" /* yacc.c:1646  */
+  case 3: /* stmt_seq: stmt  */
+#line 60 "tiny.y"
+                         { (yyval.list) = newList(declare(unit, (yyvsp[0].node))); }
+#line 1321 "tiny.tab.c"
     break;
 
-  case 4:
-#line 45 "tiny.y" /* yacc.c:1646  */
-    {
-                  YYSTYPE t = (yyvsp[-1]);
-					        if ( t != NULL )
-					        {
-                    while( t->sibling != NULL )
-					  		       t = t->sibling;
-					          t->sibling = (yyvsp[0]);
-					          (yyval) = (yyvsp[-1]);
-					        } else (yyval) = (yyvsp[0]);
-			        }
-#line 1340 "tiny.tab.c" /* yacc.c:1646  */
+  case 4: /* stmt_seq: stmt_seq stmt  */
+#line 62 "tiny.y"
+                                      { (yyval.list) = appendList((yyvsp[-1].list), newList(declare(unit, (yyvsp[0].node)))); }
+#line 1327 "tiny.tab.c"
     break;
 
-  case 5:
-#line 57 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1346 "tiny.tab.c" /* yacc.c:1646  */
+  case 5: /* stmt: var_stmt  */
+#line 65 "tiny.y"
+                       { (yyval.node) = (yyvsp[0].node); }
+#line 1333 "tiny.tab.c"
     break;
 
-  case 6:
-#line 58 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1352 "tiny.tab.c" /* yacc.c:1646  */
+  case 6: /* stmt: func_stmt  */
+#line 66 "tiny.y"
+                                         { (yyval.node) = (yyvsp[0].node); }
+#line 1339 "tiny.tab.c"
     break;
 
-  case 7:
-#line 62 "tiny.y" /* yacc.c:1646  */
-    {
-                 (yyval) = (yyvsp[-2]);
-                 (yyval)->child[0] = (yyvsp[-1]);
+  case 7: /* var_stmt: type_id id SEMI  */
+#line 70 "tiny.y"
+               {
+                 (yyval.node) = (yyvsp[-2].node);
+                 CHILD((yyval.node),0) = (yyvsp[-1].node);
                }
-#line 1361 "tiny.tab.c" /* yacc.c:1646  */
+#line 1348 "tiny.tab.c"
     break;
 
-  case 8:
-#line 67 "tiny.y" /* yacc.c:1646  */
-    {
-                 (yyval) = (yyvsp[-5]);   
-                 (yyval)->child[0] = (yyvsp[-4]);
-                 (yyvsp[-4])->child[0] = (yyvsp[-2]);
+  case 8: /* var_stmt: type_id id LBRACKETS num RBRACKETS SEMI  */
+#line 75 "tiny.y"
+               {
+                 (yyval.node) = (yyvsp[-5].node);   
+                 CHILD((yyval.node),0) = (yyvsp[-4].node);
+                 CHILD((yyvsp[-4].node),0) = (yyvsp[-2].node);
                }
-#line 1371 "tiny.tab.c" /* yacc.c:1646  */
+#line 1358 "tiny.tab.c"
     break;
 
-  case 9:
-#line 75 "tiny.y" /* yacc.c:1646  */
-    {
-				 	          (yyval) = newExpNode(TypeK);
-                    (yyval)->type=Integer;
-                    (yyval)->attr.name = copyString(tokenString);
+  case 9: /* type_id: INT  */
+#line 83 "tiny.y"
+                                              {
+				 	          (yyval.node) = newExpNode(TypeK);
+                    TYPE((yyval.node))=Integer;
+                    ATTR((yyval.node)).name = internString("int");
                 }
-#line 1381 "tiny.tab.c" /* yacc.c:1646  */
+#line 1368 "tiny.tab.c"
     break;
 
-  case 10:
-#line 82 "tiny.y" /* yacc.c:1646  */
-    {
-              	    (yyval) = newExpNode(TypeK);
-                    (yyval)->type=Void;
-                    (yyval)->attr.name = copyString(tokenString);
+  case 10: /* type_id: VOID  */
+#line 90 "tiny.y"
+                {
+              	    (yyval.node) = newExpNode(TypeK);
+                    TYPE((yyval.node))=Void;
+                    ATTR((yyval.node)).name = internString("void");
                 }
-#line 1391 "tiny.tab.c" /* yacc.c:1646  */
+#line 1378 "tiny.tab.c"
     break;
 
-  case 11:
-#line 90 "tiny.y" /* yacc.c:1646  */
-    {
-                  (yyval) = newStmtNode(FuncK);
-                  (yyval)->attr.name = (yyvsp[-4])->attr.name;
-                  (yyval)->child[1] = (yyvsp[-2]);
-                  (yyval)->child[2] = (yyvsp[0]);
-                  if (!strcmp((yyvsp[-5])->attr.name,"int"))
-                      (yyval)->type = Integer;
-                  else
-                      (yyval)->type = Void;
+  case 11: /* func_stmt: type_id id LPAREN params RPAREN comp_stmt  */
+#line 98 "tiny.y"
+                {
+                  (yyval.node) = newStmtNode(FuncK);
+                  ATTR((yyval.node)).name = ATTR((yyvsp[-4].node)).name;
+                  CHILD((yyval.node),1) = (yyvsp[-2].node);
+                  CHILD((yyval.node),2) = (yyvsp[0].list).head;
+                  TYPE((yyval.node)) = TYPE((yyvsp[-5].node));
                 }
-#line 1406 "tiny.tab.c" /* yacc.c:1646  */
+#line 1390 "tiny.tab.c"
     break;
 
-  case 12:
-#line 102 "tiny.y" /* yacc.c:1646  */
-    {
-	              	(yyval) = newStmtNode(ParamsK);
-	              	(yyval)->child[0] = (yyvsp[0]);
+  case 12: /* params: param_list  */
+#line 107 "tiny.y"
+                        {
+	              	(yyval.node) = newStmtNode(ParamsK);
+	              	CHILD((yyval.node),0) = (yyvsp[0].list).head;
 	              }
-#line 1415 "tiny.tab.c" /* yacc.c:1646  */
+#line 1399 "tiny.tab.c"
     break;
 
-  case 13:
-#line 108 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = NULL; }
-#line 1421 "tiny.tab.c" /* yacc.c:1646  */
+  case 13: /* params: VOID  */
+#line 113 "tiny.y"
+                      { (yyval.node) = NONODE; }
+#line 1405 "tiny.tab.c"
     break;
 
-  case 14:
-#line 112 "tiny.y" /* yacc.c:1646  */
-    {
-						        YYSTYPE t = (yyvsp[-2]);
-                    if (t != NULL)
-                    {
-                    	while (t->sibling != NULL)
-                        	t = t->sibling;
-                      t->sibling = (yyvsp[0]);
-                      (yyval) = (yyvsp[-2]);
-                    } else (yyval) = (yyvsp[0]);
-                }
-#line 1436 "tiny.tab.c" /* yacc.c:1646  */
+  case 14: /* param_list: param_list COMMA param  */
+#line 117 "tiny.y"
+                                              { (yyval.list) = appendList((yyvsp[-2].list), newList((yyvsp[0].node))); }
+#line 1411 "tiny.tab.c"
     break;
 
-  case 15:
-#line 123 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1442 "tiny.tab.c" /* yacc.c:1646  */
+  case 15: /* param_list: param  */
+#line 119 "tiny.y"
+                { (yyval.list) = newList((yyvsp[0].node)); }
+#line 1417 "tiny.tab.c"
     break;
 
-  case 16:
-#line 127 "tiny.y" /* yacc.c:1646  */
-    {
-                  (yyval) = (yyvsp[-1]);
-                  (yyval)->child[0] = (yyvsp[0]);
+  case 16: /* param: type_id id  */
+#line 123 "tiny.y"
+                {
+                  (yyval.node) = (yyvsp[-1].node);
+                  CHILD((yyval.node),0) = (yyvsp[0].node);
                 }
-#line 1451 "tiny.tab.c" /* yacc.c:1646  */
+#line 1426 "tiny.tab.c"
     break;
 
-  case 17:
-#line 133 "tiny.y" /* yacc.c:1646  */
-    {
-                  (yyval) = (yyvsp[-3]);
-                  (yyval)->child[0] = (yyvsp[-2]);
+  case 17: /* param: type_id id LBRACKETS RBRACKETS  */
+#line 129 "tiny.y"
+                {
+                  (yyval.node) = (yyvsp[-3].node);
+                  CHILD((yyval.node),0) = (yyvsp[-2].node);
                 }
-#line 1460 "tiny.tab.c" /* yacc.c:1646  */
+#line 1435 "tiny.tab.c"
     break;
 
-  case 18:
-#line 140 "tiny.y" /* yacc.c:1646  */
-    {
-                      YYSTYPE t = (yyvsp[-2]);
-                      if (t != NULL)
-                      {
-                        while (t->sibling != NULL)
-                             t = t->sibling;
-                        t->sibling = (yyvsp[-1]);
-                        (yyval) = (yyvsp[-2]);
-                      } else (yyval) = (yyvsp[-1]);
-                  }
-#line 1475 "tiny.tab.c" /* yacc.c:1646  */
+  case 18: /* comp_stmt: LKEY local_stmt stmtem_seq RKEY  */
+#line 136 "tiny.y"
+                 { (yyval.list) = appendList((yyvsp[-2].list), (yyvsp[-1].list)); }
+#line 1441 "tiny.tab.c"
     break;
 
-  case 19:
-#line 153 "tiny.y" /* yacc.c:1646  */
-    {
-                      YYSTYPE t = (yyvsp[-1]);
-                      if (t != NULL)
-                      {
-                          while (t->sibling != NULL)
-                              t = t->sibling;
-                          t->sibling = (yyvsp[0]);
-                          (yyval) = (yyvsp[-1]);
-                      } else (yyval) = (yyvsp[0]);
-                  }
-#line 1490 "tiny.tab.c" /* yacc.c:1646  */
+  case 19: /* local_stmt: local_stmt var_stmt  */
+#line 140 "tiny.y"
+                  { (yyval.list) = appendList((yyvsp[-1].list), newList((yyvsp[0].node))); }
+#line 1447 "tiny.tab.c"
     break;
 
-  case 20:
-#line 163 "tiny.y" /* yacc.c:1646  */
-    {(yyval) = NULL;}
-#line 1496 "tiny.tab.c" /* yacc.c:1646  */
+  case 20: /* local_stmt: empty  */
+#line 141 "tiny.y"
+                    {(yyval.list) = newList(NONODE);}
+#line 1453 "tiny.tab.c"
     break;
 
-  case 21:
-#line 168 "tiny.y" /* yacc.c:1646  */
-    {
-                  YYSTYPE t = (yyvsp[-1]);
-					        if ( t != NULL )
-					        {
-                    while( t->sibling != NULL )
-					  		       t = t->sibling;
-					          t->sibling = (yyvsp[0]);
-					          (yyval) = (yyvsp[-1]);
-					        } else (yyval) = (yyvsp[0]);
-			        }
-#line 1511 "tiny.tab.c" /* yacc.c:1646  */
+  case 21: /* stmtem_seq: stmtem_seq stmtem  */
+#line 146 "tiny.y"
+                                      { (yyval.list) = appendList((yyvsp[-1].list), (yyvsp[0].list)); }
+#line 1459 "tiny.tab.c"
     break;
 
-  case 22:
-#line 178 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = NULL; }
-#line 1517 "tiny.tab.c" /* yacc.c:1646  */
+  case 22: /* stmtem_seq: empty  */
+#line 147 "tiny.y"
+                                      { (yyval.list) = newList(NONODE); }
+#line 1465 "tiny.tab.c"
     break;
 
-  case 23:
-#line 181 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1523 "tiny.tab.c" /* yacc.c:1646  */
+  case 23: /* stmtem: exp_stmt  */
+#line 150 "tiny.y"
+                         { (yyval.list) = newList((yyvsp[0].node)); }
+#line 1471 "tiny.tab.c"
     break;
 
-  case 24:
-#line 182 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1529 "tiny.tab.c" /* yacc.c:1646  */
+  case 24: /* stmtem: comp_stmt  */
+#line 151 "tiny.y"
+                                                       { (yyval.list) = (yyvsp[0].list); }
+#line 1477 "tiny.tab.c"
     break;
 
-  case 25:
-#line 183 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1535 "tiny.tab.c" /* yacc.c:1646  */
+  case 25: /* stmtem: if_stmt  */
+#line 152 "tiny.y"
+                                 { (yyval.list) = newList((yyvsp[0].node)); }
+#line 1483 "tiny.tab.c"
     break;
 
-  case 26:
-#line 184 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1541 "tiny.tab.c" /* yacc.c:1646  */
+  case 26: /* stmtem: while_stmt  */
+#line 153 "tiny.y"
+                                           { (yyval.list) = newList((yyvsp[0].node)); }
+#line 1489 "tiny.tab.c"
     break;
 
-  case 27:
-#line 185 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1547 "tiny.tab.c" /* yacc.c:1646  */
+  case 27: /* stmtem: return_stmt  */
+#line 154 "tiny.y"
+                         { (yyval.list) = newList((yyvsp[0].node)); }
+#line 1495 "tiny.tab.c"
     break;
 
-  case 28:
-#line 189 "tiny.y" /* yacc.c:1646  */
-    {(yyval) = (yyvsp[-1]);}
-#line 1553 "tiny.tab.c" /* yacc.c:1646  */
+  case 28: /* exp_stmt: exp SEMI  */
+#line 158 "tiny.y"
+               {(yyval.node) = (yyvsp[-1].node);}
+#line 1501 "tiny.tab.c"
     break;
 
-  case 29:
-#line 191 "tiny.y" /* yacc.c:1646  */
-    {(yyval) = NULL;}
-#line 1559 "tiny.tab.c" /* yacc.c:1646  */
+  case 29: /* exp_stmt: SEMI  */
+#line 160 "tiny.y"
+               {(yyval.node) = NONODE;}
+#line 1507 "tiny.tab.c"
     break;
 
-  case 30:
-#line 195 "tiny.y" /* yacc.c:1646  */
-    {
-                     (yyval) = newStmtNode(IfK);
-					           (yyval)->child[0] = (yyvsp[-2]);
-                   	 (yyval)->child[1] = (yyvsp[0]);
+  case 30: /* if_stmt: IF LPAREN exp RPAREN stmtem  */
+#line 164 "tiny.y"
+                                               {
+                     (yyval.node) = newStmtNode(IfK);
+					           CHILD((yyval.node),0) = (yyvsp[-2].node);
+                   	 CHILD((yyval.node),1) = (yyvsp[0].list).head;
 					       }
-#line 1569 "tiny.tab.c" /* yacc.c:1646  */
+#line 1517 "tiny.tab.c"
     break;
 
-  case 31:
-#line 201 "tiny.y" /* yacc.c:1646  */
-    {
-						          (yyval) = newStmtNode(IfK);
-	                  	(yyval)->child[0] = (yyvsp[-4]);
-	                  	(yyval)->child[1] = (yyvsp[-2]);
-	                  	(yyval)->child[2] = (yyvsp[0]);
+  case 31: /* if_stmt: IF LPAREN exp RPAREN stmtem ELSE stmtem  */
+#line 170 "tiny.y"
+                                               {
+						          (yyval.node) = newStmtNode(IfK);
+	                  	CHILD((yyval.node),0) = (yyvsp[-4].node);
+	                  	CHILD((yyval.node),1) = (yyvsp[-2].list).head;
+	                  	CHILD((yyval.node),2) = (yyvsp[0].list).head;
 	               }
-#line 1580 "tiny.tab.c" /* yacc.c:1646  */
+#line 1528 "tiny.tab.c"
     break;
 
-  case 32:
-#line 210 "tiny.y" /* yacc.c:1646  */
-    {
-        				  (yyval) = newStmtNode(WhileK);
-                  (yyval)->child[0] = (yyvsp[-2]);
-                  (yyval)->child[1] = (yyvsp[0]);
+  case 32: /* while_stmt: WHILE LPAREN exp RPAREN stmtem  */
+#line 179 "tiny.y"
+                                        {
+        				  (yyval.node) = newStmtNode(WhileK);
+                  CHILD((yyval.node),0) = (yyvsp[-2].node);
+                  CHILD((yyval.node),1) = (yyvsp[0].list).head;
         				}
-#line 1590 "tiny.tab.c" /* yacc.c:1646  */
+#line 1538 "tiny.tab.c"
     break;
 
-  case 33:
-#line 218 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = newStmtNode(ReturnK); }
-#line 1596 "tiny.tab.c" /* yacc.c:1646  */
+  case 33: /* return_stmt: RETURN SEMI  */
+#line 187 "tiny.y"
+                  { (yyval.node) = newStmtNode(ReturnK); }
+#line 1544 "tiny.tab.c"
     break;
 
-  case 34:
-#line 220 "tiny.y" /* yacc.c:1646  */
-    {
-                    (yyval) = newStmtNode(ReturnK);
-                    (yyval)->child[0] = (yyvsp[-1]);
+  case 34: /* return_stmt: RETURN exp SEMI  */
+#line 189 "tiny.y"
+                  {
+                    (yyval.node) = newStmtNode(ReturnK);
+                    CHILD((yyval.node),0) = (yyvsp[-1].node);
                   }
-#line 1605 "tiny.tab.c" /* yacc.c:1646  */
+#line 1553 "tiny.tab.c"
     break;
 
-  case 35:
-#line 227 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = newStmtNode(AssignK);
-                (yyval)->child[0] = (yyvsp[-2]);
-                (yyval)->child[1] = (yyvsp[0]);
+  case 35: /* exp: var ASSIGN exp  */
+#line 196 "tiny.y"
+                          { (yyval.node) = newStmtNode(AssignK);
+                CHILD((yyval.node),0) = (yyvsp[-2].node);
+                CHILD((yyval.node),1) = (yyvsp[0].node);
               }
-#line 1614 "tiny.tab.c" /* yacc.c:1646  */
+#line 1562 "tiny.tab.c"
     break;
 
-  case 36:
-#line 232 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1620 "tiny.tab.c" /* yacc.c:1646  */
+  case 36: /* exp: simples_exp  */
+#line 201 "tiny.y"
+                 { (yyval.node) = (yyvsp[0].node); }
+#line 1568 "tiny.tab.c"
     break;
 
-  case 37:
-#line 236 "tiny.y" /* yacc.c:1646  */
-    {(yyval) = (yyvsp[0]);}
-#line 1626 "tiny.tab.c" /* yacc.c:1646  */
+  case 37: /* var: id  */
+#line 205 "tiny.y"
+               {(yyval.node) = (yyvsp[0].node);}
+#line 1574 "tiny.tab.c"
     break;
 
-  case 38:
-#line 238 "tiny.y" /* yacc.c:1646  */
-    {
-                 (yyval) = newExpNode(VectorK);
-                 (yyval)->attr.name = (yyvsp[-3])->attr.name;
-                 (yyval)->child[0] = (yyvsp[-1]);
+  case 38: /* var: id LBRACKETS exp RBRACKETS  */
+#line 207 "tiny.y"
+               {
+                 (yyval.node) = newExpNode(VectorK);
+                 ATTR((yyval.node)).name = ATTR((yyvsp[-3].node)).name;
+                 CHILD((yyval.node),0) = (yyvsp[-1].node);
                }
-#line 1636 "tiny.tab.c" /* yacc.c:1646  */
+#line 1584 "tiny.tab.c"
     break;
 
-  case 39:
-#line 246 "tiny.y" /* yacc.c:1646  */
-    {
-									(yyval) = newExpNode(OpK);
-               		(yyval)->attr.op = (yyvsp[-1])->attr.op;
-               		(yyval)->child[0] = (yyvsp[-2]);
-		            	(yyval)->child[1] = (yyvsp[0]);
+  case 39: /* simples_exp: soma_exp relacional soma_exp  */
+#line 215 "tiny.y"
+                                {
+									(yyval.node) = newExpNode(OpK);
+               		ATTR((yyval.node)).op = ATTR((yyvsp[-1].node)).op;
+               		CHILD((yyval.node),0) = (yyvsp[-2].node);
+		            	CHILD((yyval.node),1) = (yyvsp[0].node);
              	}
-#line 1647 "tiny.tab.c" /* yacc.c:1646  */
+#line 1595 "tiny.tab.c"
     break;
 
-  case 40:
-#line 252 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1653 "tiny.tab.c" /* yacc.c:1646  */
+  case 40: /* simples_exp: soma_exp  */
+#line 221 "tiny.y"
+                      { (yyval.node) = (yyvsp[0].node); }
+#line 1601 "tiny.tab.c"
     break;
 
-  case 41:
-#line 255 "tiny.y" /* yacc.c:1646  */
-    {
-											(yyval) = newExpNode(OpK);
-                   		(yyval)->attr.op = LTEQ;
+  case 41: /* relacional: LTEQ  */
+#line 224 "tiny.y"
+                   {
+											(yyval.node) = newExpNode(OpK);
+                   		ATTR((yyval.node)).op = LTEQ;
 									 }
-#line 1662 "tiny.tab.c" /* yacc.c:1646  */
+#line 1610 "tiny.tab.c"
     break;
 
-  case 42:
-#line 259 "tiny.y" /* yacc.c:1646  */
-    {
-											(yyval) = newExpNode(OpK);
-                    	(yyval)->attr.op = LT;
+  case 42: /* relacional: LT  */
+#line 228 "tiny.y"
+                  {
+											(yyval.node) = newExpNode(OpK);
+                    	ATTR((yyval.node)).op = LT;
 									}
-#line 1671 "tiny.tab.c" /* yacc.c:1646  */
+#line 1619 "tiny.tab.c"
     break;
 
-  case 43:
-#line 263 "tiny.y" /* yacc.c:1646  */
-    {
-											(yyval) = newExpNode(OpK);
-                   		(yyval)->attr.op = GT;
+  case 43: /* relacional: GT  */
+#line 232 "tiny.y"
+                        {
+											(yyval.node) = newExpNode(OpK);
+                   		ATTR((yyval.node)).op = GT;
 									}
-#line 1680 "tiny.tab.c" /* yacc.c:1646  */
+#line 1628 "tiny.tab.c"
     break;
 
-  case 44:
-#line 267 "tiny.y" /* yacc.c:1646  */
-    {
-											(yyval) = newExpNode(OpK);
-                    	(yyval)->attr.op = GTEQ;
+  case 44: /* relacional: GTEQ  */
+#line 236 "tiny.y"
+                         {
+											(yyval.node) = newExpNode(OpK);
+                    	ATTR((yyval.node)).op = GTEQ;
 									 }
-#line 1689 "tiny.tab.c" /* yacc.c:1646  */
+#line 1637 "tiny.tab.c"
     break;
 
-  case 45:
-#line 271 "tiny.y" /* yacc.c:1646  */
-    {
-											(yyval) = newExpNode(OpK);
-                   		(yyval)->attr.op = EQUAL;
+  case 45: /* relacional: EQUAL  */
+#line 240 "tiny.y"
+                          {
+											(yyval.node) = newExpNode(OpK);
+                   		ATTR((yyval.node)).op = EQUAL;
 										}
-#line 1698 "tiny.tab.c" /* yacc.c:1646  */
+#line 1646 "tiny.tab.c"
     break;
 
-  case 46:
-#line 275 "tiny.y" /* yacc.c:1646  */
-    {
-										  (yyval) = newExpNode(OpK);
-                   	  (yyval)->attr.op = DIFF;
+  case 46: /* relacional: DIFF  */
+#line 244 "tiny.y"
+                         {
+										  (yyval.node) = newExpNode(OpK);
+                   	  ATTR((yyval.node)).op = DIFF;
                     }
-#line 1707 "tiny.tab.c" /* yacc.c:1646  */
+#line 1655 "tiny.tab.c"
     break;
 
-  case 47:
-#line 282 "tiny.y" /* yacc.c:1646  */
-    {
-										(yyval) = newExpNode(OpK);
-                   	(yyval)->child[0] = (yyvsp[-2]);
-		                (yyval)->child[1] = (yyvsp[0]);
-                   	(yyval)->attr.op = PLUS;
+  case 47: /* soma_exp: soma_exp PLUS term  */
+#line 251 "tiny.y"
+                            {
+										(yyval.node) = newExpNode(OpK);
+                   	CHILD((yyval.node),0) = (yyvsp[-2].node);
+		                CHILD((yyval.node),1) = (yyvsp[0].node);
+                   	ATTR((yyval.node)).op = PLUS;
                 }
-#line 1718 "tiny.tab.c" /* yacc.c:1646  */
+#line 1666 "tiny.tab.c"
     break;
 
-  case 48:
-#line 289 "tiny.y" /* yacc.c:1646  */
-    {
-										(yyval) = newExpNode(OpK);
-                    (yyval)->child[0] = (yyvsp[-2]);
-           		      (yyval)->child[1] = (yyvsp[0]);
-                    (yyval)->attr.op = MINUS;
+  case 48: /* soma_exp: soma_exp MINUS term  */
+#line 258 "tiny.y"
+                          {
+										(yyval.node) = newExpNode(OpK);
+                    CHILD((yyval.node),0) = (yyvsp[-2].node);
+           		      CHILD((yyval.node),1) = (yyvsp[0].node);
+                    ATTR((yyval.node)).op = MINUS;
                  }
-#line 1729 "tiny.tab.c" /* yacc.c:1646  */
+#line 1677 "tiny.tab.c"
     break;
 
-  case 49:
-#line 295 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1735 "tiny.tab.c" /* yacc.c:1646  */
+  case 49: /* soma_exp: term  */
+#line 264 "tiny.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 1683 "tiny.tab.c"
     break;
 
-  case 50:
-#line 299 "tiny.y" /* yacc.c:1646  */
-    {
-								 	 (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = TIMES;
+  case 50: /* term: term TIMES factor  */
+#line 268 "tiny.y"
+                 {
+								 	 (yyval.node) = newExpNode(OpK);
+                   CHILD((yyval.node),0) = (yyvsp[-2].node);
+                   CHILD((yyval.node),1) = (yyvsp[0].node);
+                   ATTR((yyval.node)).op = TIMES;
                  }
-#line 1746 "tiny.tab.c" /* yacc.c:1646  */
+#line 1694 "tiny.tab.c"
     break;
 
-  case 51:
-#line 306 "tiny.y" /* yacc.c:1646  */
-    {
-								 	 (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = OVER;
+  case 51: /* term: term OVER factor  */
+#line 275 "tiny.y"
+                 {
+								 	 (yyval.node) = newExpNode(OpK);
+                   CHILD((yyval.node),0) = (yyvsp[-2].node);
+                   CHILD((yyval.node),1) = (yyvsp[0].node);
+                   ATTR((yyval.node)).op = OVER;
                  }
-#line 1757 "tiny.tab.c" /* yacc.c:1646  */
+#line 1705 "tiny.tab.c"
     break;
 
-  case 52:
-#line 312 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1763 "tiny.tab.c" /* yacc.c:1646  */
+  case 52: /* term: factor  */
+#line 281 "tiny.y"
+                     { (yyval.node) = (yyvsp[0].node); }
+#line 1711 "tiny.tab.c"
     break;
 
-  case 53:
-#line 316 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[-1]); }
-#line 1769 "tiny.tab.c" /* yacc.c:1646  */
+  case 53: /* factor: LPAREN exp RPAREN  */
+#line 285 "tiny.y"
+                 { (yyval.node) = (yyvsp[-1].node); }
+#line 1717 "tiny.tab.c"
     break;
 
-  case 54:
-#line 318 "tiny.y" /* yacc.c:1646  */
-    {(yyval) = (yyvsp[0]);}
-#line 1775 "tiny.tab.c" /* yacc.c:1646  */
+  case 54: /* factor: var  */
+#line 287 "tiny.y"
+                                                                  {(yyval.node) = (yyvsp[0].node);}
+#line 1723 "tiny.tab.c"
     break;
 
-  case 55:
-#line 320 "tiny.y" /* yacc.c:1646  */
-    {(yyval) = (yyvsp[0]);}
-#line 1781 "tiny.tab.c" /* yacc.c:1646  */
+  case 55: /* factor: call  */
+#line 289 "tiny.y"
+                                                                  {(yyval.node) = (yyvsp[0].node);}
+#line 1729 "tiny.tab.c"
     break;
 
-  case 56:
-#line 322 "tiny.y" /* yacc.c:1646  */
-    {(yyval) = (yyvsp[0]);}
-#line 1787 "tiny.tab.c" /* yacc.c:1646  */
+  case 56: /* factor: num  */
+#line 291 "tiny.y"
+                                                                  {(yyval.node) = (yyvsp[0].node);}
+#line 1735 "tiny.tab.c"
     break;
 
-  case 57:
-#line 327 "tiny.y" /* yacc.c:1646  */
-    {
-                (yyval) = newStmtNode(CallK);
-                (yyval)->attr.name = (yyvsp[-3])->attr.name;
-                (yyval)->child[0] = (yyvsp[-1]);
+  case 57: /* call: id LPAREN args RPAREN  */
+#line 296 "tiny.y"
+              {
+                (yyval.node) = newStmtNode(CallK);
+                ATTR((yyval.node)).name = ATTR((yyvsp[-3].node)).name;
+                CHILD((yyval.node),0) = (yyvsp[-1].node);
               }
-#line 1797 "tiny.tab.c" /* yacc.c:1646  */
+#line 1745 "tiny.tab.c"
     break;
 
-  case 58:
-#line 335 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1803 "tiny.tab.c" /* yacc.c:1646  */
+  case 58: /* args: arg_list  */
+#line 304 "tiny.y"
+                { (yyval.node) = (yyvsp[0].list).head; }
+#line 1751 "tiny.tab.c"
     break;
 
-  case 60:
-#line 340 "tiny.y" /* yacc.c:1646  */
-    {
-                  YYSTYPE t = (yyvsp[-2]);
-                  if (t != NULL)
-                  {
-                      while (t->sibling != NULL)
-                        t = t->sibling;
-                      t->sibling = (yyvsp[0]);
-                      (yyval) = (yyvsp[-2]);
-                  } else (yyval) = (yyvsp[0]);
-               }
-#line 1818 "tiny.tab.c" /* yacc.c:1646  */
+  case 60: /* arg_list: arg_list COMMA exp  */
+#line 309 "tiny.y"
+              { (yyval.list) = appendList((yyvsp[-2].list), newList((yyvsp[0].node))); }
+#line 1757 "tiny.tab.c"
     break;
 
-  case 61:
-#line 351 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[0]); }
-#line 1824 "tiny.tab.c" /* yacc.c:1646  */
+  case 61: /* arg_list: exp  */
+#line 311 "tiny.y"
+               { (yyval.list) = newList((yyvsp[0].node)); }
+#line 1763 "tiny.tab.c"
     break;
 
-  case 62:
-#line 357 "tiny.y" /* yacc.c:1646  */
-    {
-                	(yyval) = newExpNode(IdK);
-                 (yyval)->attr.name = copyString(tokenString);
+  case 62: /* id: ID  */
+#line 317 "tiny.y"
+               {
+                	(yyval.node) = newExpNode(IdK);
+                 ATTR((yyval.node)).name = (yyvsp[0].name);
                }
-#line 1833 "tiny.tab.c" /* yacc.c:1646  */
+#line 1772 "tiny.tab.c"
     break;
 
-  case 63:
-#line 364 "tiny.y" /* yacc.c:1646  */
-    {
-                 (yyval) = newExpNode(ConstK);
-                 (yyval)->attr.val = atoi(copyString(tokenString));
+  case 63: /* num: NUM  */
+#line 324 "tiny.y"
+               {
+                 (yyval.node) = newExpNode(ConstK);
+                 ATTR((yyval.node)).val = (yyvsp[0].val);
                }
-#line 1842 "tiny.tab.c" /* yacc.c:1646  */
+#line 1781 "tiny.tab.c"
     break;
 
-  case 64:
-#line 370 "tiny.y" /* yacc.c:1646  */
-    { (yyval) = NULL; }
-#line 1848 "tiny.tab.c" /* yacc.c:1646  */
+  case 64: /* empty: %empty  */
+#line 330 "tiny.y"
+                  { (yyval.node) = NONODE; }
+#line 1787 "tiny.tab.c"
     break;
 
 
-#line 1852 "tiny.tab.c" /* yacc.c:1646  */
+#line 1791 "tiny.tab.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1862,25 +1802,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -1891,50 +1829,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (unit, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -1949,7 +1851,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, unit);
           yychar = YYEMPTY;
         }
     }
@@ -1963,12 +1865,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1985,13 +1886,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2005,7 +1907,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, unit);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2017,7 +1919,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2028,33 +1930,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (unit, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, unit);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2063,37 +1969,150 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, unit);
       YYPOPSTACK (1);
     }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  return yyresult;
-}
-#line 372 "tiny.y" /* yacc.c:1906  */
+  yyps->yynew = 2;
+  goto yypushreturn;
+
 
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
 
-int yyerror(char * message)
-{ fprintf(listing,"Syntax error at line %d: %s\n",lineno,message);
+  return yyresult;
+}
+#undef yynerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yystacksize
+#line 332 "tiny.y"
+
+
+int yyerror(Compilation * unit, const char * message)
+{ /* the lexeme of a token from the token array
+   * is not null terminated
+   */
+  char * lexeme = (char *) malloc(unit->tokenLength+1);
+  fprintf(listing,"Syntax error at line %d: %s\n",lineOf(position),message);
   fprintf(listing,"Current token: ");
-  printToken(yychar,tokenString);
+  if (lexeme != NULL)
+  { memcpy(lexeme,unit->tokenString,unit->tokenLength);
+    lexeme[unit->tokenLength] = '\0';
+    printToken(unit->token,lexeme);
+    free(lexeme);
+  }
   Error = TRUE;
   return 0;
 }
 
+TokenType parserToken(Compilation * unit, YYSTYPE * value)
+{ /* no semantic value is needed without a tree */
+  if (SyntaxOnly) value = NULL;
+  if (unit->tokens != NULL) return nextToken(unit,value);
+  if (unit->lexer != NULL) return pipedToken(unit,value);
+  return getToken(unit,value);
+}
+
 /* yylex calls getToken to make Yacc/Bison output
  * compatible with ealier versions of the TINY scanner
  */
-static int yylex(void)
-{ return getToken(); }
+static int yylex(YYSTYPE * lvalp, Compilation * unit)
+{ return parserToken(unit,lvalp); }
+
+Node parse(void)
+{ struct timespec start, end;
+  if (PreLex && (compilation->tokens == NULL))
+  { if (! lexTokens(compilation))
+    { Error = TRUE;
+      return NONODE;
+    }
+  }
+  else if (Pipeline && (compilation->tokens == NULL))
+  { if (! startLexer(compilation))
+    { fprintf(listing,"Unable to create lexer thread\n");
+      Error = TRUE;
+      return NONODE;
+    }
+  }
+  rewindTokens(compilation);
+  clock_gettime(CLOCK_MONOTONIC,&start);
+#if HANDPARSE
+  compilation->parsed = (descentParse(compilation) == 0);
+#else
+  compilation->parsed = (yyparse(compilation) == 0);
+#endif
+  clock_gettime(CLOCK_MONOTONIC,&end);
+  compilation->parseSeconds = (end.tv_sec - start.tv_sec)
+                              + (end.tv_nsec - start.tv_nsec) / 1e9;
+  /* the parser stops at the first syntax error,
+   * maybe long before the lexer thread is done
+   */
+  stopLexer(compilation);
+  return compilation->syntaxTree;
+}
+
+/* Function declare passes the top-level
+ * declaration t, just parsed, to the declared
+ * procedure of the compilation, if any, which
+ * takes it: t is left out of the syntax tree.
+ * It returns what is left for the tree
+ */
+static Node declare(Compilation * unit, Node t)
+{ if ((unit->declared == NULL) || (t == NONODE)) return t;
+  unit->declared(t);
+  return NONODE;
+}
+
+int beginParse(void)
+{ compilation->parser = yypstate_new();
+  return compilation->parser != NULL;
+}
+
+int parseChunk(const char * chunk, size_t length)
+{ Compilation * c = compilation;
+  int last = (length == 0);
+  int status = YYPUSH_MORE;
+  YYSTYPE value;
+  TokenType token;
+  if (c->parser == NULL) return FALSE;
+  if (! feedText(c->scanner,chunk,length))
+  { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+    Error = TRUE;
+    status = 1;
+  }
+  else if (beginSlice(c->scanner,last))
+  { /* the ENDFILE at the end of a slice is the
+     * end of the source only in the last one
+     */
+    while (((token = getToken(c,&value)) != YYEOF) || last)
+    { status = yypush_parse(c->parser,token,&value,c);
+      if ((status != YYPUSH_MORE) || (token == YYEOF)) break;
+    }
+    if (! endSlice(c->scanner))
+    { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+      Error = TRUE;
+      status = 1;
+    }
+  }
+  if ((status == YYPUSH_MORE) && ! last) return TRUE;
+  /* PROGRAM is reduced before the token after it
+   * is read: only an accepting parse ends well
+   */
+  c->parsed = (status == 0);
+  freeParser(c);
+  return FALSE;
+}
 
-TreeNode * parse(void)
-{ yyparse();
-  return savedTree;
+void freeParser(Compilation * c)
+{ if (c->parser == NULL) return;
+  yypstate_delete(c->parser);
+  c->parser = NULL;
 }
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_TINY_TAB_H_INCLUDED
 # define YY_YY_TINY_TAB_H_INCLUDED
 /* Debug traces.  */
@@ -40,52 +45,82 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    ID = 258,
-    NUM = 259,
-    SEMI = 260,
-    COMMA = 261,
-    IF = 262,
-    INT = 263,
-    ELSE = 264,
-    RETURN = 265,
-    VOID = 266,
-    WHILE = 267,
-    ASSIGN = 268,
-    EQUAL = 269,
-    LT = 270,
-    LTEQ = 271,
-    GT = 272,
-    GTEQ = 273,
-    DIFF = 274,
-    LPAREN = 275,
-    RPAREN = 276,
-    LBRACKETS = 277,
-    RBRACKETS = 278,
-    LKEY = 279,
-    RKEY = 280,
-    PLUS = 281,
-    MINUS = 282,
-    TIMES = 283,
-    OVER = 284,
-    ERROR = 285
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ID = 258,                      /* ID  */
+    NUM = 259,                     /* NUM  */
+    SEMI = 260,                    /* SEMI  */
+    COMMA = 261,                   /* COMMA  */
+    IF = 262,                      /* IF  */
+    INT = 263,                     /* INT  */
+    ELSE = 264,                    /* ELSE  */
+    RETURN = 265,                  /* RETURN  */
+    VOID = 266,                    /* VOID  */
+    WHILE = 267,                   /* WHILE  */
+    ASSIGN = 268,                  /* ASSIGN  */
+    EQUAL = 269,                   /* EQUAL  */
+    LT = 270,                      /* LT  */
+    LTEQ = 271,                    /* LTEQ  */
+    GT = 272,                      /* GT  */
+    GTEQ = 273,                    /* GTEQ  */
+    DIFF = 274,                    /* DIFF  */
+    LPAREN = 275,                  /* LPAREN  */
+    RPAREN = 276,                  /* RPAREN  */
+    LBRACKETS = 277,               /* LBRACKETS  */
+    RBRACKETS = 278,               /* RBRACKETS  */
+    LKEY = 279,                    /* LKEY  */
+    RKEY = 280,                    /* RKEY  */
+    PLUS = 281,                    /* PLUS  */
+    MINUS = 282,                   /* MINUS  */
+    TIMES = 283,                   /* TIMES  */
+    OVER = 284,                    /* OVER  */
+    ERROR = 285                    /* ERROR  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef int YYSTYPE;
+union YYSTYPE
+{
+#line 21 "tiny.y"
+ Node node;
+         NodeList list;
+         char * name; /* interned identifier of an ID */
+         int val; /* value of a NUM */ 
+
+#line 100 "tiny.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
+typedef struct yypstate yypstate;
+
+
+int yyparse (Compilation * unit);
+int yypush_parse (yypstate *ps,
+                  int pushed_char, YYSTYPE const *pushed_val, Compilation * unit);
+int yypull_parse (yypstate *ps, Compilation * unit);
+yypstate *yypstate_new (void);
+void yypstate_delete (yypstate *ps);
+
 
 #endif /* !YY_YY_TINY_TAB_H_INCLUDED  */
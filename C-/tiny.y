@@ -9,21 +9,31 @@
 
 #include "globals.h"
 #include "util.h"
-#include "scan.h"
-#include "parse.h"
+#include "intern.h"
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
-#define YYSTYPE TreeNode *
-int yyerror(char * message);
-static char * savedName; /* for use in assignments */
-static int savedLineNo;  /* ditto */
-static TreeNode * savedTree; /* stores syntax tree for later return */
-static int yylex(void);
+%}
+%define api.pure full
+%define api.push-pull both
+%param {Compilation * unit}
+%union { Node node;
+         NodeList list;
+         char * name; /* interned identifier of an ID */
+         int val; /* value of a NUM */ }
+%{
+#include "parse.h"
+#include "scan.h"
+#include "tokens.h"
+#include "pipeline.h"
 
+static int yylex(YYSTYPE * lvalp, Compilation * unit);
+static Node declare(Compilation * unit, Node t);
 %}
 %start PROGRAM
-%token ID NUM
+%token <name> ID
+%token <val> NUM
 %token SEMI COMMA
 %token IF INT ELSE RETURN VOID WHILE
 %token ASSIGN EQUAL LT LTEQ GT GTEQ DIFF
@@ -33,25 +43,23 @@ static int yylex(void);
 %token ERROR
 %expect 1
 
+%type <node> stmt var_stmt type_id func_stmt params param
+%type <node> exp_stmt if_stmt while_stmt return_stmt
+%type <node> exp var simples_exp relacional soma_exp term factor
+%type <node> call args id num empty
+%type <list> stmt_seq param_list comp_stmt local_stmt
+%type <list> stmtem_seq stmtem arg_list
+
 %% /* Grammar for C- */
 PROGRAM 	: stmt_seq
-							{savedTree = $1;}
+							{unit->syntaxTree = $1.head;}
 					;
 
 //BEGIN FUCTION
 
-stmt_seq	 :  stmt { $$ =  $1; }
+stmt_seq	 :  stmt { $$ = newList(declare(unit, $1)); }
 					 |	stmt_seq stmt
-				      {
-                  YYSTYPE t = $1;
-					        if ( t != NULL )
-					        {
-                    while( t->sibling != NULL )
-					  		       t = t->sibling;
-					          t->sibling = $2;
-					          $$ = $1;
-					        } else $$ = $2;
-			        }
+				      { $$ = appendList($1, newList(declare(unit, $2))); }
 		       ;
 
 stmt       : var_stmt  { $$ = $1; }
@@ -61,156 +69,117 @@ stmt       : var_stmt  { $$ = $1; }
 var_stmt   : type_id id SEMI
                {
                  $$ = $1;
-                 $$->child[0] = $2;
+                 CHILD($$,0) = $2;
                }
            | type_id id LBRACKETS num RBRACKETS SEMI
                {
                  $$ = $1;   
-                 $$->child[0] = $2;
-                 $2->child[0] = $4;
+                 CHILD($$,0) = $2;
+                 CHILD($2,0) = $4;
                }
            ;
 
 type_id   : INT
 					      {
 				 	          $$ = newExpNode(TypeK);
-                    $$->type=Integer;
-                    $$->attr.name = copyString(tokenString);
+                    TYPE($$)=Integer;
+                    ATTR($$).name = internString("int");
                 }
 
           | VOID
                 {
               	    $$ = newExpNode(TypeK);
-                    $$->type=Void;
-                    $$->attr.name = copyString(tokenString);
+                    TYPE($$)=Void;
+                    ATTR($$).name = internString("void");
                 }
           ;
 
 func_stmt   : type_id id LPAREN params RPAREN comp_stmt
                 {
                   $$ = newStmtNode(FuncK);
-                  $$->attr.name = $2->attr.name;
-                  $$->child[1] = $4;
-                  $$->child[2] = $6;
-                  if (!strcmp($1->attr.name,"int"))
-                      $$->type = Integer;
-                  else
-                      $$->type = Void;
+                  ATTR($$).name = ATTR($2).name;
+                  CHILD($$,1) = $4;
+                  CHILD($$,2) = $6.head;
+                  TYPE($$) = TYPE($1);
                 }
 						;
 params      : param_list
 	            	{
 	              	$$ = newStmtNode(ParamsK);
-	              	$$->child[0] = $1;
+	              	CHILD($$,0) = $1.head;
 	              }
 
 	    	    | VOID
-	              { $$ = NULL; }
+	              { $$ = NONODE; }
 	    	    ;
 
 param_list  : param_list COMMA param
-					      {
-						        YYSTYPE t = $1;
-                    if (t != NULL)
-                    {
-                    	while (t->sibling != NULL)
-                        	t = t->sibling;
-                      t->sibling = $3;
-                      $$ = $1;
-                    } else $$ = $3;
-                }
+					      { $$ = appendList($1, newList($3)); }
             | param
-                { $$ = $1; }
+                { $$ = newList($1); }
             ;
 
 param       : type_id id
                 {
                   $$ = $1;
-                  $$->child[0] = $2;
+                  CHILD($$,0) = $2;
                 }
 
             | type_id id LBRACKETS RBRACKETS
                 {
                   $$ = $1;
-                  $$->child[0] = $2;
+                  CHILD($$,0) = $2;
                 }
             ;
 
 comp_stmt   : LKEY local_stmt stmtem_seq RKEY
-                 {
-                      YYSTYPE t = $2;
-                      if (t != NULL)
-                      {
-                        while (t->sibling != NULL)
-                             t = t->sibling;
-                        t->sibling = $3;
-                        $$ = $2;
-                      } else $$ = $3;
-                  }
+                 { $$ = appendList($2, $3); }
             ;
 
 local_stmt  : local_stmt var_stmt
-                  {
-                      YYSTYPE t = $1;
-                      if (t != NULL)
-                      {
-                          while (t->sibling != NULL)
-                              t = t->sibling;
-                          t->sibling = $2;
-                          $$ = $1;
-                      } else $$ = $2;
-                  }
-            | empty {$$ = NULL;}
+                  { $$ = appendList($1, newList($2)); }
+            | empty {$$ = newList(NONODE);}
             ;
 //END FUNCTION
 
 stmtem_seq	 : stmtem_seq stmtem
-				      {
-                  YYSTYPE t = $1;
-					        if ( t != NULL )
-					        {
-                    while( t->sibling != NULL )
-					  		       t = t->sibling;
-					          t->sibling = $2;
-					          $$ = $1;
-					        } else $$ = $2;
-			        }
-			     |  empty { $$ = NULL; }
+				      { $$ = appendList($1, $2); }
+			     |  empty { $$ = newList(NONODE); }
 		       ;
 
-stmtem     : exp_stmt    { $$ = $1; }
+stmtem     : exp_stmt    { $$ = newList($1); }
 					 | comp_stmt   { $$ = $1; }
-    		   | if_stmt     { $$ = $1; }
-			     | while_stmt  { $$ = $1; }
-           | return_stmt { $$ = $1; }
+    		   | if_stmt     { $$ = newList($1); }
+			     | while_stmt  { $$ = newList($1); }
+           | return_stmt { $$ = newList($1); }
 			     ;
 
 exp_stmt    : exp SEMI
                {$$ = $1;}
             | SEMI
-               {$$ = NULL;}
+               {$$ = NONODE;}
             ;
 
 if_stmt		  : IF LPAREN exp RPAREN stmtem
 					       {
                      $$ = newStmtNode(IfK);
-					           $$->child[0] = $3;
-                   	 $$->child[1] = $5;
+					           CHILD($$,0) = $3;
+                   	 CHILD($$,1) = $5.head;
 					       }
 			      | IF LPAREN exp RPAREN stmtem ELSE stmtem
 					       {
 						          $$ = newStmtNode(IfK);
-	                  	$$->child[0] = $3;
-	                  	$$->child[1] = $5;
-	                  	$$->child[2] = $7;
+	                  	CHILD($$,0) = $3;
+	                  	CHILD($$,1) = $5.head;
+	                  	CHILD($$,2) = $7.head;
 	               }
 	         ;
 
 while_stmt : WHILE LPAREN exp RPAREN stmtem
 				        {
         				  $$ = newStmtNode(WhileK);
-                  $$->child[0] = $3;
-                  $$->child[1] = $5;
+                  CHILD($$,0) = $3;
+                  CHILD($$,1) = $5.head;
         				}
 			      ;
 
@@ -219,14 +188,14 @@ return_stmt : RETURN SEMI
             | RETURN exp SEMI
                   {
                     $$ = newStmtNode(ReturnK);
-                    $$->child[0] = $2;
+                    CHILD($$,0) = $2;
                   }
             ;
 
 exp			   : var ASSIGN exp
 		          { $$ = newStmtNode(AssignK);
-                $$->child[0] = $1;
-                $$->child[1] = $3;
+                CHILD($$,0) = $1;
+                CHILD($$,1) = $3;
               }
  	            | simples_exp
                  { $$ = $1; }
@@ -237,60 +206,60 @@ var        : id
            | id LBRACKETS exp RBRACKETS
                {
                  $$ = newExpNode(VectorK);
-                 $$->attr.name = $1->attr.name;
-                 $$->child[0] = $3;
+                 ATTR($$).name = ATTR($1).name;
+                 CHILD($$,0) = $3;
                }
            ;
 
 simples_exp : soma_exp relacional soma_exp
 		          	{
 									$$ = newExpNode(OpK);
-               		$$->attr.op = $2->attr.op;
-               		$$->child[0] = $1;
-		            	$$->child[1] = $3;
+               		ATTR($$).op = ATTR($2).op;
+               		CHILD($$,0) = $1;
+		            	CHILD($$,1) = $3;
              	}
            | soma_exp { $$ = $1; }
            ;
 
 relacional  : LTEQ {
 											$$ = newExpNode(OpK);
-                   		$$->attr.op = LTEQ;
+                   		ATTR($$).op = LTEQ;
 									 }
             | LT  {
 											$$ = newExpNode(OpK);
-                    	$$->attr.op = LT;
+                    	ATTR($$).op = LT;
 									}
 	          | GT  {
 											$$ = newExpNode(OpK);
-                   		$$->attr.op = GT;
+                   		ATTR($$).op = GT;
 									}
 	          | GTEQ {
 											$$ = newExpNode(OpK);
-                    	$$->attr.op = GTEQ;
+                    	ATTR($$).op = GTEQ;
 									 }
 	          | EQUAL {
 											$$ = newExpNode(OpK);
-                   		$$->attr.op = EQUAL;
+                   		ATTR($$).op = EQUAL;
 										}
 	          | DIFF {
 										  $$ = newExpNode(OpK);
-                   	  $$->attr.op = DIFF;
+                   	  ATTR($$).op = DIFF;
                     }
            ;
 
 soma_exp   : soma_exp PLUS term
 		            {
 										$$ = newExpNode(OpK);
-                   	$$->child[0] = $1;
-		                $$->child[1] = $3;
-                   	$$->attr.op = PLUS;
+                   	CHILD($$,0) = $1;
+		                CHILD($$,1) = $3;
+                   	ATTR($$).op = PLUS;
                 }
            |  soma_exp MINUS term
            		  {
 										$$ = newExpNode(OpK);
-                    $$->child[0] = $1;
-           		      $$->child[1] = $3;
-                    $$->attr.op = MINUS;
+                    CHILD($$,0) = $1;
+           		      CHILD($$,1) = $3;
+                    ATTR($$).op = MINUS;
                  }
            | term { $$ = $1; }
            ;
@@ -298,16 +267,16 @@ soma_exp   : soma_exp PLUS term
 term       : term TIMES factor
                  {
 								 	 $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = TIMES;
+                   CHILD($$,0) = $1;
+                   CHILD($$,1) = $3;
+                   ATTR($$).op = TIMES;
                  }
             | term OVER factor
                  {
 								 	 $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = OVER;
+                   CHILD($$,0) = $1;
+                   CHILD($$,1) = $3;
+                   ATTR($$).op = OVER;
                  }
             | factor { $$ = $1; }
             ;
@@ -326,29 +295,20 @@ factor      : LPAREN exp RPAREN
 call        : id LPAREN args RPAREN
               {
                 $$ = newStmtNode(CallK);
-                $$->attr.name = $1->attr.name;
-                $$->child[0] = $3;
+                ATTR($$).name = ATTR($1).name;
+                CHILD($$,0) = $3;
               }
             ;
 
 args        : arg_list
-                { $$ = $1; }
+                { $$ = $1.head; }
             | empty
             ;
 
 arg_list  : arg_list COMMA exp
-              {
-                  YYSTYPE t = $1;
-                  if (t != NULL)
-                  {
-                      while (t->sibling != NULL)
-                        t = t->sibling;
-                      t->sibling = $3;
-                      $$ = $1;
-                  } else $$ = $3;
-               }
+              { $$ = appendList($1, newList($3)); }
           | exp
-               { $$ = $1; }
+               { $$ = newList($1); }
           ;
 
 //*************END CALL FUCTION ***************
@@ -356,36 +316,138 @@ arg_list  : arg_list COMMA exp
 id 			   : ID
                {
                 	$$ = newExpNode(IdK);
-                 $$->attr.name = copyString(tokenString);
+                 ATTR($$).name = $1;
                }
            ;
 
 num        : NUM
                {
                  $$ = newExpNode(ConstK);
-                 $$->attr.val = atoi(copyString(tokenString));
+                 ATTR($$).val = $1;
                }
            ;
 
-empty 		: { $$ = NULL; }
+empty 		: { $$ = NONODE; }
 					;
 %%
 
-int yyerror(char * message)
-{ fprintf(listing,"Syntax error at line %d: %s\n",lineno,message);
+int yyerror(Compilation * unit, const char * message)
+{ /* the lexeme of a token from the token array
+   * is not null terminated
+   */
+  char * lexeme = (char *) malloc(unit->tokenLength+1);
+  fprintf(listing,"Syntax error at line %d: %s\n",lineOf(position),message);
   fprintf(listing,"Current token: ");
-  printToken(yychar,tokenString);
+  if (lexeme != NULL)
+  { memcpy(lexeme,unit->tokenString,unit->tokenLength);
+    lexeme[unit->tokenLength] = '\0';
+    printToken(unit->token,lexeme);
+    free(lexeme);
+  }
   Error = TRUE;
   return 0;
 }
 
+TokenType parserToken(Compilation * unit, YYSTYPE * value)
+{ /* no semantic value is needed without a tree */
+  if (SyntaxOnly) value = NULL;
+  if (unit->tokens != NULL) return nextToken(unit,value);
+  if (unit->lexer != NULL) return pipedToken(unit,value);
+  return getToken(unit,value);
+}
+
 /* yylex calls getToken to make Yacc/Bison output
  * compatible with ealier versions of the TINY scanner
  */
-static int yylex(void)
-{ return getToken(); }
+static int yylex(YYSTYPE * lvalp, Compilation * unit)
+{ return parserToken(unit,lvalp); }
+
+Node parse(void)
+{ struct timespec start, end;
+  if (PreLex && (compilation->tokens == NULL))
+  { if (! lexTokens(compilation))
+    { Error = TRUE;
+      return NONODE;
+    }
+  }
+  else if (Pipeline && (compilation->tokens == NULL))
+  { if (! startLexer(compilation))
+    { fprintf(listing,"Unable to create lexer thread\n");
+      Error = TRUE;
+      return NONODE;
+    }
+  }
+  rewindTokens(compilation);
+  clock_gettime(CLOCK_MONOTONIC,&start);
+#if HANDPARSE
+  compilation->parsed = (descentParse(compilation) == 0);
+#else
+  compilation->parsed = (yyparse(compilation) == 0);
+#endif
+  clock_gettime(CLOCK_MONOTONIC,&end);
+  compilation->parseSeconds = (end.tv_sec - start.tv_sec)
+                              + (end.tv_nsec - start.tv_nsec) / 1e9;
+  /* the parser stops at the first syntax error,
+   * maybe long before the lexer thread is done
+   */
+  stopLexer(compilation);
+  return compilation->syntaxTree;
+}
+
+/* Function declare passes the top-level
+ * declaration t, just parsed, to the declared
+ * procedure of the compilation, if any, which
+ * takes it: t is left out of the syntax tree.
+ * It returns what is left for the tree
+ */
+static Node declare(Compilation * unit, Node t)
+{ if ((unit->declared == NULL) || (t == NONODE)) return t;
+  unit->declared(t);
+  return NONODE;
+}
+
+int beginParse(void)
+{ compilation->parser = yypstate_new();
+  return compilation->parser != NULL;
+}
+
+int parseChunk(const char * chunk, size_t length)
+{ Compilation * c = compilation;
+  int last = (length == 0);
+  int status = YYPUSH_MORE;
+  YYSTYPE value;
+  TokenType token;
+  if (c->parser == NULL) return FALSE;
+  if (! feedText(c->scanner,chunk,length))
+  { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+    Error = TRUE;
+    status = 1;
+  }
+  else if (beginSlice(c->scanner,last))
+  { /* the ENDFILE at the end of a slice is the
+     * end of the source only in the last one
+     */
+    while (((token = getToken(c,&value)) != YYEOF) || last)
+    { status = yypush_parse(c->parser,token,&value,c);
+      if ((status != YYPUSH_MORE) || (token == YYEOF)) break;
+    }
+    if (! endSlice(c->scanner))
+    { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+      Error = TRUE;
+      status = 1;
+    }
+  }
+  if ((status == YYPUSH_MORE) && ! last) return TRUE;
+  /* PROGRAM is reduced before the token after it
+   * is read: only an accepting parse ends well
+   */
+  c->parsed = (status == 0);
+  freeParser(c);
+  return FALSE;
+}
 
-TreeNode * parse(void)
-{ yyparse();
-  return savedTree;
+void freeParser(Compilation * c)
+{ if (c->parser == NULL) return;
+  yypstate_delete(c->parser);
+  c->parser = NULL;
 }
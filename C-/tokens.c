@@ -0,0 +1,132 @@
+/****************************************************/
+/* File: tokens.c                                   */
+/* Token array implementation                       */
+/* for the CMINUS compiler                          */
+/****************************************************/
+
+#include "globals.h"
+#include "scan.h"
+#include "intern.h"
+#include "tokens.h"
+#include <limits.h>
+
+/* INITSIZE is the initial number of tokens
+ * in the array
+ */
+#define INITSIZE 1024
+
+/* tokenKind maps a token to the byte kept in its
+ * record: ENDFILE is 0 and the tokens of the
+ * parser, all from ID on, follow it
+ */
+#define tokenKind(t) ((t) == ENDFILE ? 0 : (t) - ID + 1)
+#define kindToken(k) ((k) == 0 ? ENDFILE : (int) (k) + ID - 1)
+
+/* Function addToken appends the token just read
+ * by getToken to array a
+ */
+static int addToken( TokenArray * a, Compilation * c, TokenType token )
+{ Token * t;
+  if (c->tokenLength > MAXLEXEME) return FALSE;
+  if (a->count == a->size)
+  { unsigned long size = a->size ? 2*a->size : INITSIZE;
+    Token * tokens = (Token *) realloc(a->tokens,size*sizeof(Token));
+    if (tokens == NULL) return FALSE;
+    a->tokens = tokens;
+    a->size = size;
+  }
+  t = &a->tokens[a->count++];
+  t->offset = position;
+  t->kind = tokenKind(token);
+  t->length = (unsigned) c->tokenLength;
+  return TRUE;
+}
+
+/* Function lexTokens scans the whole source of
+ * compilation c into its token array. It returns
+ * FALSE if memory is exhausted or the source is
+ * too large for the array. The values of IDs and
+ * NUMs are left for nextToken to make
+ */
+int lexTokens( Compilation * c )
+{ TokenArray * a = (TokenArray *) calloc(1,sizeof(TokenArray));
+  TokenType token;
+  if (a == NULL)
+  { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+    return FALSE;
+  }
+  a->text = scannerText(c->scanner);
+  c->tokens = a;
+  do
+  { token = getToken(c,NULL);
+    if (! addToken(a,c,token))
+    { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+      freeTokens(c);
+      return FALSE;
+    }
+  } while (token != ENDFILE);
+  return TRUE;
+}
+
+/* Function lexemeValue returns the value of the
+ * digits of a NUM, as atoi does, reading no more
+ * than its length bytes
+ */
+static int lexemeValue( const char * s, size_t length )
+{ unsigned long v = 0;
+  size_t i;
+  for (i=0;i<length;i++)
+  { unsigned d = (unsigned) (s[i] - '0');
+    if (v > (unsigned long) (LONG_MAX - d) / 10)
+    { v = LONG_MAX;
+      break;
+    }
+    v = 10*v + d;
+  }
+  return (int) (long) v;
+}
+
+/* Function setToken makes token the current
+ * token of compilation c
+ */
+TokenType setToken( Compilation * c, TokenType token, const char * text,
+                    unsigned offset, size_t length, YYSTYPE * value )
+{ c->token = token;
+  c->tokenString = (char *) text + offset;
+  c->tokenLength = length;
+  position = offset;
+  if (value == NULL) return token;
+  if (token == ID)
+    value->name = internSlice(c->tokenString,length);
+  else if (token == NUM)
+    value->val = lexemeValue(c->tokenString,length);
+  return token;
+}
+
+/* Function nextToken returns the next token of
+ * the token array of compilation c
+ */
+TokenType nextToken( Compilation * c, YYSTYPE * value )
+{ TokenArray * a = c->tokens;
+  const Token * t = &a->tokens[a->next];
+  /* stay on ENDFILE once it is reached */
+  if (a->next+1 < a->count) a->next++;
+  return setToken(c,kindToken(t->kind),a->text,t->offset,t->length,value);
+}
+
+/* Procedure rewindTokens makes the next call to
+ * nextToken return the first token again
+ */
+void rewindTokens( Compilation * c )
+{ if (c->tokens != NULL) c->tokens->next = 0;
+}
+
+/* Procedure freeTokens releases the token array
+ * of compilation c
+ */
+void freeTokens( Compilation * c )
+{ if (c->tokens == NULL) return;
+  free(c->tokens->tokens);
+  free(c->tokens);
+  c->tokens = NULL;
+}
@@ -0,0 +1,76 @@
+/****************************************************/
+/* File: tokens.h                                   */
+/* Token array for the CMINUS compiler: the whole   */
+/* source is scanned before parsing into a flat     */
+/* array that the parser then reads from, so that   */
+/* scanning and parsing run as separate stages      */
+/****************************************************/
+
+#ifndef _TOKENS_H_
+#define _TOKENS_H_
+
+/* The record of each token: where its lexeme
+ * is in the source text, which is also the
+ * position of the token (see lineOf). kind and
+ * length share one word, so a token takes 8
+ * bytes
+ */
+typedef struct
+   { unsigned offset;     /* of the lexeme in the text */
+     unsigned kind : 8;   /* see tokenKind in tokens.c */
+     unsigned length : 24; /* bytes in the lexeme */
+   } Token;
+
+/* MAXLEXEME is the longest lexeme a Token can hold */
+#define MAXLEXEME 0xffffff
+
+typedef struct TokenArrayRec
+   { Token * tokens; /* the last one is ENDFILE */
+     unsigned long count;
+     unsigned long size;  /* tokens allocated */
+     unsigned long next;  /* next token for the parser */
+     const char * text;   /* text the offsets refer to */
+   } TokenArray;
+
+/* Function lexTokens scans the whole source of
+ * compilation c into its token array. It returns
+ * FALSE if memory is exhausted or the source is
+ * too large for the array
+ */
+int lexTokens( Compilation * c );
+
+/* Function setToken makes token, whose lexeme
+ * is the length bytes at offset in text, the
+ * current token of compilation c, as getToken
+ * does for a token it scans, and returns it: it
+ * stores its semantic value in *value, unless
+ * value is NULL, its
+ * lexeme (not null terminated) in c->tokenString
+ * and c->tokenLength and its offset in position.
+ * Only the length bytes of the lexeme are read
+ */
+TokenType setToken( Compilation * c, TokenType token, const char * text,
+                    unsigned offset, size_t length, YYSTYPE * value );
+
+/* Function nextToken returns the next token of
+ * the token array of compilation c, like getToken
+ * does from the source: it stores its semantic
+ * value in *value, its lexeme (not null
+ * terminated) in c->tokenString and c->tokenLength
+ * and its offset in position
+ */
+TokenType nextToken( Compilation * c, YYSTYPE * value );
+
+/* Procedure rewindTokens makes the next call to
+ * nextToken return the first token again, so that
+ * the source can be parsed again without being
+ * scanned again
+ */
+void rewindTokens( Compilation * c );
+
+/* Procedure freeTokens releases the token array
+ * of compilation c
+ */
+void freeTokens( Compilation * c );
+
+#endif
@@ -8,6 +8,12 @@
 
 #include "globals.h"
 #include "util.h"
+#include "arena.h"
+#include "intern.h"
+#include "scan.h"
+#include "symtab.h"
+#include "tokens.h"
+#include "parse.h"
 
 /* Procedure printToken prints a token
  * and its lexeme to the listing file
@@ -60,62 +66,234 @@ void printToken( TokenType token, const char* tokenString )
   }
 }
 
-/* Function newStmtNode creates a new statement
- * node for syntax tree construction
+/* scratch is the node every builder returns in
+ * syntax-only mode: the parser actions write
+ * into it, but nothing ever reads it
+ */
+static THREAD Node scratch = NONODE;
+
+#if COMPACTAST
+/* INITNODES is the number of nodes the tree
+ * store first makes room for
+ */
+#define INITNODES 1024
+
+/* NODEBYTES is the size of the fields of a node */
+#define NODEBYTES (4*sizeof(unsigned char) + sizeof(unsigned) \
+                   + (MAXCHILDREN+1)*sizeof(Node) + sizeof(NodeAttr) \
+                   + sizeof(struct SymbolRec *))
+
+/* GROW resizes array a of the tree store to
+ * size elements, or leaves growTree with FALSE
+ */
+#define GROW(a) \
+  { void * m = realloc((a),size*sizeof(*(a))); \
+    if (m==NULL) return FALSE; \
+    (a) = m; \
+  }
+
+/* Function growTree doubles the arrays of the
+ * tree store s and returns FALSE when there is
+ * no memory, or no index, left for them
  */
-TreeNode * newStmtNode(StmtKind kind)
-{ TreeNode * t = (TreeNode *) malloc(sizeof(TreeNode));
+static int growTree( TreeStore * s )
+{ unsigned long size = (s->size == 0) ? INITNODES : 2*s->size;
+  /* every index must fit in a Node */
+  if ((Node) (size-1) != size-1) return FALSE;
+  GROW(s->nodekind);
+  GROW(s->kind);
+  GROW(s->type);
+  GROW(s->seen);
+  GROW(s->pos);
+  GROW(s->child);
+  GROW(s->sibling);
+  GROW(s->attr);
+  GROW(s->symbol);
+  s->size = size;
+  return TRUE;
+}
+
+/* Function allocNode returns the index of a new
+ * node in the tree store, or NONODE
+ */
+static Node allocNode(void)
+{ TreeStore * s = &compilation->tree;
+  if (s->count == 0) s->count = 1; /* index 0 is no node */
+  if ((s->count >= s->size) && ! growTree(s)) return NONODE;
+  return (Node) s->count++;
+}
+
+/* Procedure releaseTree frees the arrays of the
+ * tree store s
+ */
+static void releaseTree( TreeStore * s )
+{ free(s->nodekind);
+  free(s->kind);
+  free(s->type);
+  free(s->seen);
+  free(s->pos);
+  free(s->child);
+  free(s->sibling);
+  free(s->attr);
+  free(s->symbol);
+  memset(s,0,sizeof(TreeStore));
+}
+#else
+/* NODEBYTES is the size of a node */
+#define NODEBYTES sizeof(TreeNode)
+
+/* Function allocNode returns a new node from the
+ * tree arena, or NONODE
+ */
+static Node allocNode(void)
+{ return (Node) arenaAlloc(&compilation->treeArena,sizeof(TreeNode));
+}
+#endif
+
+/* Function newNode creates a new node of kind
+ * nodekind with no children, siblings or symbol
+ */
+static Node newNode(NodeKind nodekind)
+{ Node t;
   int i;
-  if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
-  else {
-    for (i=0;i<MAXCHILDREN;i++) t->child[i] = NULL;
-    t->sibling = NULL;
-    t->nodekind = StmtK;
-    t->kind.stmt = kind;
-    t->lineno = lineno;
+  if (SyntaxOnly && (scratch != NONODE)) return scratch;
+  t = allocNode();
+  if (t==NONODE)
+  { fprintf(listing,"Out of memory error at line %d\n",lineOf(position));
+    return NONODE;
   }
+  for (i=0;i<MAXCHILDREN;i++) CHILD(t,i) = NONODE;
+  SIBLING(t) = NONODE;
+  SEEN(t) = FALSE;
+  SYMBOL(t) = NULL;
+  NODEKIND(t) = nodekind;
+  POS(t) = position;
+  if (SyntaxOnly) scratch = t;
+  else compilation->nodeCount++;
+  return t;
+}
+
+/* Function newStmtNode creates a new statement
+ * node for syntax tree construction
+ */
+Node newStmtNode(StmtKind kind)
+{ Node t = newNode(StmtK);
+  if (t!=NONODE) STMTKIND(t) = kind;
   return t;
 }
 
 /* Function newExpNode creates a new expression
  * node for syntax tree construction
  */
-TreeNode * newExpNode(ExpKind kind)
-{ TreeNode * t = (TreeNode *) malloc(sizeof(TreeNode));
-  int i;
-  if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
-  else {
-    for (i=0;i<MAXCHILDREN;i++) t->child[i] = NULL;
-    t->sibling = NULL;
-    t->nodekind = ExpK;
-    t->kind.exp = kind;
-    t->lineno = lineno;
-    t->type = Void;
+Node newExpNode(ExpKind kind)
+{ Node t = newNode(ExpK);
+  if (t!=NONODE)
+  { EXPKIND(t) = kind;
+    TYPE(t) = Void;
   }
   return t;
 }
 
-/* Function copyString allocates and makes a new
- * copy of an existing string
+/* Function newList makes a sibling list whose
+ * head is t (an empty list if t is NONODE, and
+ * always in syntax-only mode)
  */
-char * copyString(char * s)
-{ int n;
-  char * t;
-  if (s==NULL) return NULL;
-  n = strlen(s)+1;
-  t = malloc(n);
-  if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
-  else strcpy(t,s);
-  return t;
+NodeList newList(Node t)
+{ NodeList l;
+  if (SyntaxOnly) t = NONODE;
+  l.head = l.tail = t;
+  if (t != NONODE)
+    while (SIBLING(l.tail) != NONODE)
+      l.tail = SIBLING(l.tail);
+  return l;
+}
+
+/* Function appendList links list b after the
+ * tail of list a in constant time
+ */
+NodeList appendList(NodeList a, NodeList b)
+{ if (a.head == NONODE) return b;
+  if (b.head == NONODE) return a;
+  SIBLING(a.tail) = b.head;
+  a.tail = b.tail;
+  return a;
+}
+
+/* Procedure freeTree releases every tree node
+ * created since the previous call at once
+ */
+void freeTree(void)
+{ arenaRelease(&compilation->treeArena);
+#if COMPACTAST
+  /* the arrays are kept for the next nodes */
+  compilation->tree.count = 0;
+#endif
+  scratch = NONODE;
+  compilation->nodeCount = 0;
+}
+
+/* Procedure printAllocStats prints the allocation
+ * counters of the current compilation to the
+ * listing file, with the time the type check of
+ * a separate pass took to walk the tree
+ */
+void printAllocStats(void)
+{ fprintf(listing,"\nTree allocation:\n");
+  fprintf(listing,"  nodes:   %lu (%lu bytes each)\n",
+          compilation->nodeCount,(unsigned long) NODEBYTES);
+#if COMPACTAST
+  fprintf(listing,"  store:   %lu nodes reserved\n",compilation->tree.size);
+#endif
+  fprintf(listing,"  names:   %lu distinct\n",internCount());
+  fprintf(listing,"  bytes:   %lu used, %lu reserved in %lu chunks\n",
+          compilation->treeArena.bytes,compilation->treeArena.reserved,
+          compilation->treeArena.nchunks);
+  if (! FusedAnalysis && ! Streaming && ! SyntaxOnly)
+    fprintf(listing,"  type check: %.3f s\n",compilation->checkSeconds);
+}
+
+/* Function newCompilation returns an empty
+ * compilation of the file input and makes it
+ * the current compilation of the calling thread.
+ * It returns NULL if the source cannot be read,
+ * with the reason in *failure (see newScanner)
+ */
+Compilation * newCompilation( FILE * input, int * failure )
+{ Compilation * c = (Compilation *) calloc(1,sizeof(Compilation));
+  *failure = NOMEMORY;
+  if (c!=NULL) c->scanner = newScanner(input,failure);
+  if ((c==NULL) || (c->scanner==NULL))
+  { free(c);
+    return NULL;
+  }
+  compilation = c;
+  position = 0;
+  Error = FALSE;
+  return c;
+}
+
+/* Procedure freeCompilation releases compilation c
+ * with its scanner, tree, names and symbol table
+ */
+void freeCompilation( Compilation * c )
+{ compilation = c;
+  freeTokens(c);
+  freeParser(c);
+  freeScanner(c->scanner);
+  freeTree();
+#if COMPACTAST
+  releaseTree(&c->tree);
+#endif
+  internRelease();
+  st_release();
+  free(c);
+  compilation = NULL;
 }
 
 /* Variable indentno is used by printTree to
  * store current number of spaces to indent
  */
-static int indentno = 0;
+static THREAD int indentno = 0;
 
 /* macros to increase/decrease indentation */
 #define INDENT indentno+=2
@@ -131,13 +309,13 @@ static void printSpaces(void)
 /* procedure printTree prints a syntax tree to the
  * listing file using indentation to indicate subtrees
  */
-void printTree( TreeNode * tree )
+void printTree( Node tree )
 { int i;
   INDENT;
-  while (tree != NULL) {
+  while (tree != NONODE) {
     printSpaces();
-    if (tree->nodekind==StmtK)
-    { switch (tree->kind.stmt) {
+    if (NODEKIND(tree)==StmtK)
+    { switch (STMTKIND(tree)) {
         case IfK:
           fprintf(listing,"If\n");
           break;
@@ -151,13 +329,13 @@ void printTree( TreeNode * tree )
           fprintf(listing,"Return\n");
           break;
         case FuncK:
-          if(tree->type == 1)
-            fprintf(listing,"Function: int %s\n",tree->attr.name);
+          if(TYPE(tree) == 1)
+            fprintf(listing,"Function: int %s\n",ATTR(tree).name);
           else
-            fprintf(listing,"Function: void %s\n",tree->attr.name);
+            fprintf(listing,"Function: void %s\n",ATTR(tree).name);
           break;
         case CallK:
-          fprintf(listing,"Call the Function: %s\n",tree->attr.name);
+          fprintf(listing,"Call the Function: %s\n",ATTR(tree).name);
           break;
         case ParamsK:
           fprintf(listing,"Params\n");
@@ -167,26 +345,26 @@ void printTree( TreeNode * tree )
           break;
       }
     }
-    else if (tree->nodekind==ExpK)
-    { switch (tree->kind.exp) {
+    else if (NODEKIND(tree)==ExpK)
+    { switch (EXPKIND(tree)) {
         case OpK:
           fprintf(listing,"Op: ");
-          printToken(tree->attr.op,"\0");
+          printToken(ATTR(tree).op,"\0");
           break;
         case ConstK:
-          fprintf(listing,"Const: %d\n",tree->attr.val);
+          fprintf(listing,"Const: %d\n",ATTR(tree).val);
           break;
         case IdK:
-          fprintf(listing,"Id: %s\n",tree->attr.name);
+          fprintf(listing,"Id: %s\n",ATTR(tree).name);
           break;
         case TypeK:
-          if(tree->type == 1)
+          if(TYPE(tree) == 1)
             fprintf(listing,"Type: Int\n");
           else
             fprintf(listing,"Type: Void\n");
           break;
         case VectorK:
-          fprintf(listing,"Vector: %s\n",tree->attr.name);
+          fprintf(listing,"Vector: %s\n",ATTR(tree).name);
           break;
         default:
           fprintf(listing,"Unknown ExpNode kind\n");
@@ -195,8 +373,8 @@ void printTree( TreeNode * tree )
     }
     else fprintf(listing,"Unknown node kind\n");
     for (i=0;i<MAXCHILDREN;i++)
-         printTree(tree->child[i]);
-    tree = tree->sibling;
+         printTree(CHILD(tree,i));
+    tree = SIBLING(tree);
   }
   UNINDENT;
 }
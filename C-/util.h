@@ -14,23 +14,58 @@
 void printToken( TokenType, const char* );
 
 /* Function newStmtNode creates a new statement
- * node for syntax tree construction
+ * node for syntax tree construction; in
+ * syntax-only mode it returns the same scratch
+ * node every time
  */
-TreeNode * newStmtNode(StmtKind);
+Node newStmtNode(StmtKind);
 
 /* Function newExpNode creates a new expression 
- * node for syntax tree construction
+ * node for syntax tree construction; in
+ * syntax-only mode it returns the same scratch
+ * node every time
  */
-TreeNode * newExpNode(ExpKind);
+Node newExpNode(ExpKind);
 
-/* Function copyString allocates and makes a new
- * copy of an existing string
+/* Function newList makes a sibling list whose
+ * head is t (an empty list if t is NONODE, and
+ * always in syntax-only mode)
  */
-char * copyString( char * );
+NodeList newList(Node t);
+
+/* Function appendList links list b after the
+ * tail of list a in constant time
+ */
+NodeList appendList(NodeList a, NodeList b);
+
+/* Procedure freeTree releases every tree node
+ * created since the previous call at once
+ */
+void freeTree(void);
+
+/* Procedure printAllocStats prints the allocation
+ * counters of the current compilation to the
+ * listing file, with the time the type check of
+ * a separate pass took to walk the tree
+ */
+void printAllocStats(void);
+
+/* Function newCompilation returns an empty
+ * compilation of the file input and makes it
+ * the current compilation of the calling thread.
+ * It returns NULL if the source cannot be read,
+ * with the reason in *failure (see newScanner)
+ */
+Compilation * newCompilation( FILE * input, int * failure );
+
+/* Procedure freeCompilation releases compilation c
+ * with its scanner, tree, names and symbol table
+ */
+void freeCompilation( Compilation * c );
 
 /* procedure printTree prints a syntax tree to the 
  * listing file using indentation to indicate subtrees
  */
-void printTree( TreeNode * );
+void printTree( Node );
 
 #endif